@@ -44,7 +44,8 @@ public class AsyncLoadingScreen : ModuleRules
 				"RenderCore",
 				"ApplicationCore",
 				"PreLoadScreen",
-				"DeveloperSettings"
+				"DeveloperSettings",
+				"Json"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
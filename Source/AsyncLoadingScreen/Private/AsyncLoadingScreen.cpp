@@ -16,9 +16,37 @@
 #include "SDualSidebarLayout.h"
 #include "Framework/Application/SlateApplication.h"
 #include "AsyncLoadingScreenLibrary.h"
+#include "AsyncLoadingScreenStats.h"
+#include "AsyncLoadingScreenTrace.h"
+#include "SCustomWidgetLayout.h"
+#include "LoadingScreenAssetCache.h"
+#include "LoadingScreenHistory.h"
+#include "LoadingScreenBenchmark.h"
 
 #define LOCTEXT_NAMESPACE "FAsyncLoadingScreenModule"
 
+CSV_DEFINE_CATEGORY(AsyncLoadingScreen, true);
+
+UE_TRACE_CHANNEL_DEFINE(AsyncLoadingScreenChannel);
+
+DEFINE_STAT(STAT_AsyncLoadingScreen_SlateThreadSleep);
+DEFINE_STAT(STAT_AsyncLoadingScreen_SlateThreadWork);
+DEFINE_STAT(STAT_AsyncLoadingScreen_DrawWindow);
+DEFINE_STAT(STAT_AsyncLoadingScreen_SlateTick);
+DEFINE_STAT(STAT_AsyncLoadingScreen_SlatePrepass);
+DEFINE_STAT(STAT_AsyncLoadingScreen_Paint);
+DEFINE_STAT(STAT_AsyncLoadingScreen_CursorPaint);
+DEFINE_STAT(STAT_AsyncLoadingScreen_DrawWindows);
+DEFINE_STAT(STAT_AsyncLoadingScreen_NumPaintedFrames);
+DEFINE_STAT(STAT_AsyncLoadingScreen_NumSkippedFrames);
+DEFINE_STAT(STAT_AsyncLoadingScreen_NumDrawElements);
+DEFINE_STAT(STAT_AsyncLoadingScreen_RenderThreadTick);
+DEFINE_STAT(STAT_AsyncLoadingScreen_TickStreamer);
+DEFINE_STAT(STAT_AsyncLoadingScreen_BeginFrame);
+DEFINE_STAT(STAT_AsyncLoadingScreen_EndFrame);
+DEFINE_STAT(STAT_AsyncLoadingScreen_RHIFlush);
+DEFINE_STAT(STAT_AsyncLoadingScreen_WaitForMovieFrame);
+
 
 void FAsyncLoadingScreenModule::StartupModule()
 {
@@ -34,6 +62,8 @@ void FAsyncLoadingScreenModule::StartupModule()
 			GetMoviePlayer()->OnPrepareLoadingScreen().AddRaw(this, &FAsyncLoadingScreenModule::PreSetupLoadingScreen);
 		}
 
+		FLoadingScreenHistory::Get().Register();
+
 		// Prepare the startup screen, the PreSetupLoadingScreen callback won't be called
 		// if we've already explicitly setup the loading screen
 		UAsyncLoadingScreenLibrary::SetupLoadingScreen(Settings->StartupLoadingScreen);
@@ -49,6 +79,11 @@ void FAsyncLoadingScreenModule::ShutdownModule()
 	{
 		// TODO: Unregister later
 		GetMoviePlayer()->OnPrepareLoadingScreen().RemoveAll(this);
+
+		FLoadingScreenBenchmark::Abort();
+		SCustomWidgetLayout::ReleasePreloadedWidgetClasses();
+		FLoadingScreenAssetCache::Get().Empty();
+		FLoadingScreenHistory::Get().Unregister();
 	}
 }
 
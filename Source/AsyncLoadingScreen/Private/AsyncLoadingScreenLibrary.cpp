@@ -13,6 +13,10 @@
 #include "CustomMoviePlayer.h"
 #include "LoadingScreenSettings.h"
 #include "LoadingScreenWidget.h"
+#include "SCustomWidgetLayout.h"
+#include "LoadingScreenAssetCache.h"
+#include "LoadingScreenHistory.h"
+#include "AsyncLoadingScreenTrace.h"
 
 #if WITH_EDITOR
 #pragma optimize("", off)
@@ -43,7 +47,7 @@ const FALoadingScreenSettings* UAsyncLoadingScreenLibrary::GetLoadingScreenSetti
 {
 	const ULoadingScreenSettings* settings{GetDefault<ULoadingScreenSettings>()};
 	const FALoadingScreenSettings* loading_settings{&settings->StartupLoadingScreen};
-	if (!settings_name.IsNone())
+	if (!settings_name.IsNone() && settings_name != FName(TEXT("__startup")))
 	{
 		if (settings_name == FName(TEXT("__default")))
 		{
@@ -62,8 +66,37 @@ const FALoadingScreenSettings* UAsyncLoadingScreenLibrary::GetLoadingScreenSetti
 	return loading_settings;
 }
 
+bool UAsyncLoadingScreenLibrary::FindLoadingScreenSettingsName(const FALoadingScreenSettings& loading_settings, FName& out_settings_name)
+{
+	const ULoadingScreenSettings* settings{GetDefault<ULoadingScreenSettings>()};
+	if (&loading_settings == &settings->StartupLoadingScreen)
+	{
+		out_settings_name = FName(TEXT("__startup"));
+		return true;
+	}
+
+	if (&loading_settings == &settings->DefaultLoadingScreen)
+	{
+		out_settings_name = FName(TEXT("__default"));
+		return true;
+	}
+
+	for (const TPair<FName, FALoadingScreenSettings>& custom_settings : settings->CustomLoadingScreens)
+	{
+		if (&loading_settings == &custom_settings.Value)
+		{
+			out_settings_name = custom_settings.Key;
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void UAsyncLoadingScreenLibrary::StartCustomLoadingScreen(FName custom_settings_name)
 {
+	ASYNC_LOADING_SCREEN_TRACE_SCOPE(StartCustomLoadingScreen);
+
 #if WITH_EDITOR
 	if (FCommandLine::IsInitialized() && GUseThreadedRendering && !GUsingNullRHI)
 #else
@@ -99,6 +132,16 @@ void UAsyncLoadingScreenLibrary::StartCustomLoadingScreen(FName custom_settings_
 	}
 }
 
+void UAsyncLoadingScreenLibrary::PreloadLoadingScreen(FName custom_settings_name)
+{
+	const FALoadingScreenSettings* loading_settings{GetLoadingScreenSettingsByName(custom_settings_name)};
+
+	if (loading_settings->bShowWidgetOverlay && loading_settings->Layout == EAsyncLoadingScreenLayout::ALSL_CustomWidget)
+	{
+		SCustomWidgetLayout::PreloadWidgetClass(loading_settings->CustomLoadingWidget);
+	}
+}
+
 void UAsyncLoadingScreenLibrary::SetupLoadingScreen(const FALoadingScreenSettings& loading_settings)
 {
 	if (FCustomMoviePlayer::Get() && FCustomMoviePlayer::Get()->IsMovieCurrentlyPlaying())
@@ -112,11 +155,26 @@ void UAsyncLoadingScreenLibrary::SetupLoadingScreen(const FALoadingScreenSetting
 
 void UAsyncLoadingScreenLibrary::SetupLoadingScreenInternal(IGameMoviePlayer* movie_player, const FALoadingScreenSettings& loading_settings)
 {
+	ASYNC_LOADING_SCREEN_TRACE_SCOPE(SetupLoadingScreen);
+
 	if (loading_settings.bShowWidgetOverlay == false && loading_settings.MoviePaths.Num() == 0)
 	{
 		// No loading elemets to show
 		return;
 	}
+
+	FName settings_name;
+	const bool found_settings_name = FindLoadingScreenSettingsName(loading_settings, settings_name);
+
+	if (movie_player == FCustomMoviePlayer::Get())
+	{
+		// The time to first frame is measured from here, building the widgets included
+		FCustomMoviePlayer::Get()->BeginFirstFrameMeasurement(found_settings_name ? settings_name : FName(TEXT("Unnamed")));
+	}
+	else
+	{
+		FLoadingScreenHistory::Get().BeginEngineLoadingScreen(found_settings_name ? settings_name : FName(TEXT("Unnamed")));
+	}
 	
 	TArray<FString> movies_list = loading_settings.MoviePaths;
 	// Shuffle the movies list
@@ -150,14 +208,27 @@ void UAsyncLoadingScreenLibrary::SetupLoadingScreenInternal(IGameMoviePlayer* mo
 	loading_screen.MoviePaths                        = movies_list;
 	loading_screen.PlaybackType                      = loading_settings.PlaybackType;
 
+	// Keep the assets of this loading screen loaded for the next time it shows
+	FLoadingScreenAssetCache::Get().Acquire(found_settings_name ? settings_name : NAME_None);
+
 	if (loading_settings.bShowWidgetOverlay)
 	{
 		loading_screen.WidgetLoadingScreen = ULoadingScreenWidget::CreateSlateWidget(loading_settings);
 	}
 
+	if (movie_player == FCustomMoviePlayer::Get())
+	{
+		FCustomMoviePlayer::Get()->SetRHIFlushPolicy(loading_settings.RHIFlushPolicy, loading_settings.RHIFlushInterval);
+	}
+
 	movie_player->SetupLoadingScreen(loading_screen);
 }
 
+float UAsyncLoadingScreenLibrary::GetTimeToFirstFrame()
+{
+	return FCustomMoviePlayer::Get() ? (float)FCustomMoviePlayer::Get()->GetTimeToFirstFrame() : -1.0f;
+}
+
 void UAsyncLoadingScreenLibrary::StopLoadingScreen()
 {
 	GetMoviePlayer()->StopMovie();
@@ -0,0 +1,67 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DECLARE_STATS_GROUP(TEXT("AsyncLoadingScreen"), STATGROUP_AsyncLoadingScreen, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_EXTERN(AsyncLoadingScreen);
+
+/**
+ * Times the rest of the scope with the STAT_AsyncLoadingScreen_<Stat> cycle counter ("stat AsyncLoadingScreen")
+ * and the <Stat> timing stat of the AsyncLoadingScreen CSV profiler category, on any thread.
+ */
+#define ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(STAT_AsyncLoadingScreen_##Stat); \
+	CSV_SCOPED_TIMING_STAT(AsyncLoadingScreen, Stat)
+
+// Slate loading thread
+
+/** Time the loading thread sleeps between two frames, waiting for the frame pacer or a free draw pass slot */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Slate Thread Sleep"), STAT_AsyncLoadingScreen_SlateThreadSleep, STATGROUP_AsyncLoadingScreen, );
+/** Time the loading thread spends producing a frame, movie streamer ticks included */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Slate Thread Work"), STAT_AsyncLoadingScreen_SlateThreadWork, STATGROUP_AsyncLoadingScreen, );
+/** Time spent drawing the custom loading screen window on the loading thread, the stats below included */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Draw Window"), STAT_AsyncLoadingScreen_DrawWindow, STATGROUP_AsyncLoadingScreen, );
+/** Time spent ticking the Slate application time (active timers) on the loading thread */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Slate Tick"), STAT_AsyncLoadingScreen_SlateTick, STATGROUP_AsyncLoadingScreen, );
+/** Time spent computing the desired sizes of the custom loading screen on the loading thread */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Slate Prepass"), STAT_AsyncLoadingScreen_SlatePrepass, STATGROUP_AsyncLoadingScreen, );
+/** Time spent painting the custom loading screen on the loading thread */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Paint"), STAT_AsyncLoadingScreen_Paint, STATGROUP_AsyncLoadingScreen, );
+/** Time spent painting the software cursors over the custom loading screen on the loading thread */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cursor Paint"), STAT_AsyncLoadingScreen_CursorPaint, STATGROUP_AsyncLoadingScreen, );
+/** Time spent handing the painted elements over to the Slate renderer on the loading thread */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Draw Windows"), STAT_AsyncLoadingScreen_DrawWindows, STATGROUP_AsyncLoadingScreen, );
+/** Number of frames painted by the loading thread */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Painted Frames"), STAT_AsyncLoadingScreen_NumPaintedFrames, STATGROUP_AsyncLoadingScreen, );
+/** Number of frames the loading thread skipped because nothing on the loading screen changed or the window is in the background */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Skipped Frames"), STAT_AsyncLoadingScreen_NumSkippedFrames, STATGROUP_AsyncLoadingScreen, );
+/** Number of draw elements rebuilt by the last paint of the custom loading screen, cached layers excluded */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Draw Elements"), STAT_AsyncLoadingScreen_NumDrawElements, STATGROUP_AsyncLoadingScreen, );
+
+// Render thread
+
+/** Time the render thread spends presenting a loading screen frame, the stats below included */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Render Thread Tick"), STAT_AsyncLoadingScreen_RenderThreadTick, STATGROUP_AsyncLoadingScreen, );
+/** Time the render thread spends ticking the movie streamer */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick Streamer"), STAT_AsyncLoadingScreen_TickStreamer, STATGROUP_AsyncLoadingScreen, );
+/** Time the render thread spends beginning a loading screen frame on the immediate command list */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Begin Frame"), STAT_AsyncLoadingScreen_BeginFrame, STATGROUP_AsyncLoadingScreen, );
+/** Time the render thread spends ending a loading screen frame on the immediate command list */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("End Frame"), STAT_AsyncLoadingScreen_EndFrame, STATGROUP_AsyncLoadingScreen, );
+/** Time the render thread spends flushing the RHI after the custom loading screen frames */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RHI Flush"), STAT_AsyncLoadingScreen_RHIFlush, STATGROUP_AsyncLoadingScreen, );
+
+// Game thread
+
+/** Time of a game thread frame while waiting for the custom loading screen to finish */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Wait For Movie Frame"), STAT_AsyncLoadingScreen_WaitForMovieFrame, STATGROUP_AsyncLoadingScreen, );
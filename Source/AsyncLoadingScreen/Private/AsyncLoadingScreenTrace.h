@@ -0,0 +1,22 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * Unreal Insights channel of the loading screen lifecycle and of the draw passes handed from the Slate loading thread to the render thread.
+ * Enabled along with the cpu channel, e.g. -trace=cpu,frame,loadtime,AsyncLoadingScreen
+ */
+UE_TRACE_CHANNEL_EXTERN(AsyncLoadingScreenChannel);
+
+/** Traces the rest of the scope as an AsyncLoadingScreen_<Name> timing event on AsyncLoadingScreenChannel */
+#define ASYNC_LOADING_SCREEN_TRACE_SCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("AsyncLoadingScreen_" #Name, AsyncLoadingScreenChannel)
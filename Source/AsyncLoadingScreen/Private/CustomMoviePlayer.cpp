@@ -23,12 +23,36 @@
 #include "Widgets/Layout/SDPIScaler.h"
 #include "Engine/UserInterfaceSettings.h"
 #include "Framework/Application/SlateUser.h"
+#include "LoadingScreenRedrawMetaData.h"
+#include "AsyncLoadingScreenStats.h"
+#include "AsyncLoadingScreenTrace.h"
+#include "LoadingScreenHistory.h"
+#include "RenderingThread.h"
+#include "HAL/IConsoleManager.h"
+#include "LoadingScreenSettings.h"
 
 //#if WITH_EDITOR
 //#pragma optimize("", off)
 //#endif
 
-DEFINE_LOG_CATEGORY_STATIC(LogMoviePlayer, Log, All);
+DEFINE_LOG_CATEGORY(LogMoviePlayer);
+
+static TAutoConsoleVariable<int32> CVarAsyncLoadingScreenMaxGameThreadFramesAhead(
+	TEXT("AsyncLoadingScreen.MaxGameThreadFramesAhead"),
+	-1,
+	TEXT("Number of frames the game thread may run ahead of the render thread while waiting for the custom loading screen to finish (0-2).\n")
+	TEXT("< 0: use Performance.MaxGameThreadFramesAhead from the project settings (default)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAsyncLoadingScreenPresentFirstFrameOnGameThread(
+	TEXT("AsyncLoadingScreen.PresentFirstFrameOnGameThread"),
+	-1,
+	TEXT("Paint and present the first frame of the custom loading screen on the game thread before handing over to the loading thread.\n")
+	TEXT("< 0: use Performance.bPresentFirstFrameOnGameThread from the project settings (default), 0: disable, 1: enable"),
+	ECVF_Default);
+
+/** Upper bound of AsyncLoadingScreen.MaxGameThreadFramesAhead, sizes the ring of frame fences */
+static const int32 MaxGameThreadFramesAheadLimit = 2;
 
 class SDefaultMovieBorder : public SBorder
 {
@@ -116,6 +140,17 @@ FCustomMoviePlayer::FCustomMoviePlayer()
 	, LoadingScreenAttributes()
 	, LastPlayTime(0.0)
 	, bInitialized(false)
+	, bTickableRegistered(false)
+	, RHIFlushPolicy_RenderThread(ELoadingScreenRHIFlushPolicy::LSFP_EveryFrame)
+	, RHIFlushInterval_RenderThread(1)
+	, NumLoadingFrames_RenderThread(0)
+	, SetupStartCycles(0)
+	, SetupEndCycles(0)
+	, PlayCycles(0)
+	, ArmedCycles(0)
+	, bFirstFrameMeasurementBegun(false)
+	, bFirstFramePresentedOnGameThread(false)
+	, FirstPresentCycles(0)
 {
 	FCoreDelegates::IsLoadingMovieCurrentlyPlaying.BindRaw(this, &FCustomMoviePlayer::IsMovieCurrentlyPlaying);
     FCoreDelegates::RegisterMovieStreamerDelegate.AddRaw(this, &FCustomMoviePlayer::RegisterMovieStreamer);
@@ -162,13 +197,7 @@ void FCustomMoviePlayer::Initialize(FSlateRenderer& InSlateRenderer, TSharedPtr<
 
 	UE_LOG(LogMoviePlayer, Log, TEXT("Initializing movie player"));
 
-	FCustomMoviePlayer* InMoviePlayer = this;
-	ENQUEUE_RENDER_COMMAND(RegisterMoviePlayerTickable)(
-		[InMoviePlayer](FRHICommandListImmediate& RHICmdList)
-		{
-			InMoviePlayer->Register();
-		});
-
+	// The render thread tickable is only registered while a loading screen is playing, see SetTickableRegistered
 	bInitialized = true;
 
 	// Initialize shaders, because otherwise they might not be guaranteed to exist at this point
@@ -263,12 +292,7 @@ void FCustomMoviePlayer::Shutdown()
 	StopMovie();
 	//WaitForMovieToFinish();
 
-	FCustomMoviePlayer* InMoviePlayer = this;
-	ENQUEUE_RENDER_COMMAND(UnregisterMoviePlayerTickable)(
-		[InMoviePlayer](FRHICommandListImmediate& RHICmdList)
-		{
-			InMoviePlayer->Unregister();
-		});
+	SetTickableRegistered(false);
 
 	bInitialized = false;
 
@@ -318,6 +342,8 @@ void FCustomMoviePlayer::SetupLoadingScreen(const FLoadingScreenAttributes& InLo
 	{
 		LoadingScreenAttributes = InLoadingScreenAttributes;
 	}
+
+	SetupEndCycles = FPlatformTime::Cycles64();
 }
 
 bool FCustomMoviePlayer::HasEarlyStartupMovie() const
@@ -344,6 +370,8 @@ bool FCustomMoviePlayer::PlayEarlyStartupMovies()
 
 bool FCustomMoviePlayer::PlayMovie()
 {
+	ASYNC_LOADING_SCREEN_TRACE_SCOPE(PlayMovie);
+
 	bool bBeganPlaying = false;
 
 	// Allow systems to hook onto the movie player and provide loading screen data on demand 
@@ -360,6 +388,21 @@ bool FCustomMoviePlayer::PlayMovie()
 		
 		LastPlayTime = FPlatformTime::Seconds();
 
+		// Loading screens not set up through SetupLoadingScreenInternal are measured from here
+		PlayCycles = FPlatformTime::Cycles64();
+		if (!bFirstFrameMeasurementBegun)
+		{
+			FirstFrameScreenName = NAME_None;
+			SetupStartCycles = PlayCycles;
+			SetupEndCycles = PlayCycles;
+		}
+		bFirstFrameMeasurementBegun = false;
+		bFirstFramePresentedOnGameThread = false;
+		ArmedCycles = 0;
+		FirstPresentCycles = 0;
+
+		FLoadingScreenHistory::Get().BeginLoadingScreen();
+
 		ActiveMovieStreamer.Reset();
 		if (MovieStreamingIsPrepared())
 		{
@@ -391,10 +434,25 @@ bool FCustomMoviePlayer::PlayMovie()
 			// Add loading widget into viewport to top
 			GEngine->GameViewport->AddViewportWidgetContent(VirtualRenderWindow.ToSharedRef(), 1000);
 
+			WidgetRenderer->GatherRedrawMetaData(LoadingScreenAttributes.WidgetLoadingScreen);
+
+			SetTickableRegistered(true);
+
+			const int32 PresentFirstFrameOverride = CVarAsyncLoadingScreenPresentFirstFrameOnGameThread.GetValueOnGameThread();
+			if (PresentFirstFrameOverride >= 0 ? PresentFirstFrameOverride != 0 : GetDefault<ULoadingScreenSettings>()->Performance.bPresentFirstFrameOnGameThread)
+			{
+				PresentFirstFrameOnGameThread();
+			}
+
 			{
+				// The mechanism and its thread are kept alive between loading screens, later screens only wake the parked thread up
 				FScopeLock SyncMechanismLock(&SyncMechanismCriticalSection);
-				SyncMechanism = new FCustomSlateLoadingSynchronizationMechanism(WidgetRenderer, ActiveMovieStreamer);
-				SyncMechanism->Initialize();
+				if (SyncMechanism == nullptr)
+				{
+					SyncMechanism = new FCustomSlateLoadingSynchronizationMechanism(WidgetRenderer, FConsumeSlateDrawPassDelegate::CreateRaw(this, &FCustomMoviePlayer::ConsumeSlateDrawPass));
+				}
+				ArmedCycles = FPlatformTime::Cycles64();
+				SyncMechanism->Initialize(ActiveMovieStreamer);
 			}
 
 			bBeganPlaying = true;
@@ -423,6 +481,8 @@ bool FCustomMoviePlayer::CanPlayMovie() const
 
 void FCustomMoviePlayer::StopMovie()
 {
+	ASYNC_LOADING_SCREEN_TRACE_SCOPE(StopMovie);
+
 	LastPlayTime = 0;
 	bUserCalledFinish = true;
 
@@ -431,18 +491,20 @@ void FCustomMoviePlayer::StopMovie()
 
 void FCustomMoviePlayer::WaitForMovieToFinish(bool bAllowEngineTick)
 {
+	ASYNC_LOADING_SCREEN_TRACE_SCOPE(WaitForMovieToFinish);
+
 	const bool bEnforceMinimumTime = LoadingScreenAttributes.MinimumLoadingScreenDisplayTime >= 0.0f;
 
 	if (LoadingScreenIsPrepared() && IsMovieCurrentlyPlaying())
 	{
+		const uint64 LoadingFinishedCycles = FPlatformTime::Cycles64();
+		double AverageFrameTime = 0.0;
 	
 		if (SyncMechanism)
 		{
-			SyncMechanism->DestroySlateThread();
-
-			FScopeLock SyncMechanismLock(&SyncMechanismCriticalSection);
-			delete SyncMechanism;
-			SyncMechanism = nullptr;
+			ASYNC_LOADING_SCREEN_TRACE_SCOPE(ParkSlateThread);
+			SyncMechanism->ParkSlateThread();
+			AverageFrameTime = SyncMechanism->GetAverageFrameTime();
 		}
 
 		if( !bEnforceMinimumTime )
@@ -469,6 +531,13 @@ void FCustomMoviePlayer::WaitForMovieToFinish(bool bAllowEngineTick)
 
 		FSlateApplication& SlateApp = FSlateApplication::Get();
 
+		// Each frame begins a fence and waits on the one begun FramesAhead frames earlier, instead of flushing the render thread every frame
+		const int32 FramesAheadOverride = CVarAsyncLoadingScreenMaxGameThreadFramesAhead.GetValueOnGameThread();
+		const int32 FramesAhead = FMath::Clamp(FramesAheadOverride >= 0 ? FramesAheadOverride : GetDefault<ULoadingScreenSettings>()->Performance.MaxGameThreadFramesAhead, 0, MaxGameThreadFramesAheadLimit);
+		FRenderCommandFence FrameFences[MaxGameThreadFramesAheadLimit + 1];
+		int32 NumFrames = 0;
+		const double LoopStartTime = FPlatformTime::Seconds();
+
 		// Make sure the movie player widget has user focus to accept keypresses
 		/*if (LoadingScreenContents.IsValid())
 		{
@@ -492,6 +561,9 @@ void FCustomMoviePlayer::WaitForMovieToFinish(bool bAllowEngineTick)
 
 			if (FSlateApplication::IsInitialized())
 			{
+				ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(WaitForMovieFrame);
+				ASYNC_LOADING_SCREEN_TRACE_SCOPE(WaitForMovieFrame);
+
 				// Break out of the loop if the main window is closed during the movie.
 				if ( !MainWindow.IsValid() || bMainWindowClosed.Load() )
 				{
@@ -530,7 +602,10 @@ void FCustomMoviePlayer::WaitForMovieToFinish(bool bAllowEngineTick)
 					[InMoviePlayer, DeltaTime](FRHICommandListImmediate& RHICmdList)
 					{
 						GFrameNumberRenderThread++;
-						GRHICommandList.GetImmediateCommandList().BeginFrame();
+						{
+							ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(BeginFrame);
+							GRHICommandList.GetImmediateCommandList().BeginFrame();
+						}
 				
 						InMoviePlayer->TickStreamer(DeltaTime);
 					}
@@ -547,13 +622,19 @@ void FCustomMoviePlayer::WaitForMovieToFinish(bool bAllowEngineTick)
 				}
 
 				ENQUEUE_RENDER_COMMAND(FinishLoadingMovieFrame)(
-					[](FRHICommandListImmediate& RHICmdList)
+					[InMoviePlayer](FRHICommandListImmediate& RHICmdList)
 					{
-						GRHICommandList.GetImmediateCommandList().EndFrame();
-						GRHICommandList.GetImmediateCommandList().ImmediateFlush(EImmediateFlushType::FlushRHIThreadFlushResources);
+						{
+							ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(EndFrame);
+							GRHICommandList.GetImmediateCommandList().EndFrame();
+						}
+						InMoviePlayer->FlushRHIForLoadingFrame(GRHICommandList.GetImmediateCommandList());
 					}
 				);
-				FlushRenderingCommands();
+
+				FrameFences[NumFrames % (FramesAhead + 1)].BeginFence();
+				++NumFrames;
+				FrameFences[NumFrames % (FramesAhead + 1)].Wait();
 
 				if (ActiveMovieStreamer.IsValid())
 				{
@@ -562,6 +643,13 @@ void FCustomMoviePlayer::WaitForMovieToFinish(bool bAllowEngineTick)
 			}
 		}
 
+		if (NumFrames > 0)
+		{
+			UE_LOG(LogMoviePlayer, Verbose, TEXT("Waited %d frames for the loading screen to finish: %.3f ms per frame on average, %d frames ahead of the render thread, engine tick %s"),
+				NumFrames, (FPlatformTime::Seconds() - LoopStartTime) * 1000.0 / NumFrames, FramesAhead,
+				bAllowEngineTick && LoadingScreenAttributes.bAllowEngineTick ? TEXT("on") : TEXT("off"));
+		}
+
 		LoadingIsDone.Set(1);
 		IsMoviePlaying = false;
 
@@ -574,7 +662,19 @@ void FCustomMoviePlayer::WaitForMovieToFinish(bool bAllowEngineTick)
 
 		MovieStreamingIsDone.Set(1);
 
-		FlushRenderingCommands();
+		{
+			// The last draw passes and loading frames still queued on the render thread
+			ASYNC_LOADING_SCREEN_TRACE_SCOPE(FlushLoadingFrames);
+			FlushRenderingCommands();
+		}
+
+		FLoadingScreenHistory::FRecord HistoryRecord;
+		HistoryRecord.ScreenName = FirstFrameScreenName.ToString();
+		HistoryRecord.TimeToFirstFrame = GetTimeToFirstFrame();
+		HistoryRecord.LoadTime = FPlatformTime::ToSeconds64(LoadingFinishedCycles - SetupStartCycles);
+		HistoryRecord.ExtraWaitTime = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - LoadingFinishedCycles);
+		HistoryRecord.AverageFrameTime = AverageFrameTime;
+		FLoadingScreenHistory::Get().Append(MoveTemp(HistoryRecord));
 
 		if( ActiveMovieStreamer.IsValid() )
 		{
@@ -591,6 +691,9 @@ void FCustomMoviePlayer::WaitForMovieToFinish(bool bAllowEngineTick)
 		// explicitly set the loading screen they want (rather than have stale loading screens)
 		LoadingScreenAttributes = FLoadingScreenAttributes();
 
+		// Nothing is left for the render thread to do until the next loading screen
+		SetTickableRegistered(false);
+
 		BroadcastMoviePlaybackFinished();
 	}
 	else
@@ -612,7 +715,7 @@ bool FCustomMoviePlayer::IsLoadingFinished() const
 
 bool FCustomMoviePlayer::IsMovieCurrentlyPlaying() const
 {
-	return SyncMechanism != NULL;
+	return SyncMechanism != NULL && SyncMechanism->IsSlateThreadArmed();
 }
 
 bool FCustomMoviePlayer::IsMovieStreamingFinished() const
@@ -621,30 +724,171 @@ bool FCustomMoviePlayer::IsMovieStreamingFinished() const
 }
 
 void FCustomMoviePlayer::Tick( float DeltaTime )
+{
+	// Draw passes are only consumed by the render command the slate loading thread enqueues behind their draw commands.
+	// Polling for them here could consume a pass before its draw commands ran and free its pipeline slot early.
+}
+
+void FCustomMoviePlayer::ConsumeSlateDrawPass(float DeltaTime)
 {
 	check(IsInRenderingThread());
-	if (MainWindow.IsValid() && VirtualRenderWindow.IsValid() && !IsLoadingFinished() && GDynamicRHI && !GDynamicRHI->RHIIsRenderingSuspended())
+
+	FScopeLock SyncMechanismLock(&SyncMechanismCriticalSection);
+	if (SyncMechanism && SyncMechanism->IsSlateDrawPassEnqueued())
 	{
-		FScopeLock SyncMechanismLock(&SyncMechanismCriticalSection);
-		if(SyncMechanism)
+		ASYNC_LOADING_SCREEN_TRACE_SCOPE(ConsumeDrawPass);
+
+		if (MainWindow.IsValid() && VirtualRenderWindow.IsValid() && !IsLoadingFinished() && GDynamicRHI && !GDynamicRHI->RHIIsRenderingSuspended())
 		{
-			if(SyncMechanism->IsSlateDrawPassEnqueued())
+			ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(RenderThreadTick);
+
+			GFrameNumberRenderThread++;
 			{
-				GFrameNumberRenderThread++;
+				ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(BeginFrame);
 				GRHICommandList.GetImmediateCommandList().BeginFrame();
-				TickStreamer(DeltaTime);
-				SyncMechanism->ResetSlateDrawPassEnqueued();
+			}
+			TickStreamer(DeltaTime);
+			SyncMechanism->DequeueSlateDrawPass();
+			{
+				ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(EndFrame);
 				GRHICommandList.GetImmediateCommandList().EndFrame();
-				GRHICommandList.GetImmediateCommandList().ImmediateFlush(EImmediateFlushType::FlushRHIThreadFlushResources);
 			}
+			FlushRHIForLoadingFrame(GRHICommandList.GetImmediateCommandList());
+
+			if (FirstPresentCycles.Load() == 0)
+			{
+				OnFirstFramePresented();
+			}
+		}
+		else
+		{
+			// Nothing to present, still hand the pass back so the slate loading thread doesn't wait on it
+			SyncMechanism->DequeueSlateDrawPass();
 		}
 	}
 }
 
+void FCustomMoviePlayer::SetRHIFlushPolicy(ELoadingScreenRHIFlushPolicy InRHIFlushPolicy, int32 InRHIFlushInterval)
+{
+	check(IsInGameThread());
+
+	FCustomMoviePlayer* InMoviePlayer = this;
+	const int32 RHIFlushInterval = FMath::Max(InRHIFlushInterval, 1);
+	ENQUEUE_RENDER_COMMAND(SetLoadingScreenRHIFlushPolicy)(
+		[InMoviePlayer, InRHIFlushPolicy, RHIFlushInterval](FRHICommandListImmediate& RHICmdList)
+		{
+			InMoviePlayer->RHIFlushPolicy_RenderThread = InRHIFlushPolicy;
+			InMoviePlayer->RHIFlushInterval_RenderThread = RHIFlushInterval;
+			InMoviePlayer->NumLoadingFrames_RenderThread = 0;
+		});
+}
+
+void FCustomMoviePlayer::BeginFirstFrameMeasurement(const FName& ScreenName)
+{
+	check(IsInGameThread());
+
+	FirstFrameScreenName = ScreenName;
+	SetupStartCycles = FPlatformTime::Cycles64();
+	SetupEndCycles = SetupStartCycles;
+	bFirstFrameMeasurementBegun = true;
+	FirstPresentCycles = 0;
+}
+
+double FCustomMoviePlayer::GetTimeToFirstFrame() const
+{
+	const uint64 PresentCycles = FirstPresentCycles.Load();
+	return PresentCycles != 0 ? FPlatformTime::ToSeconds64(PresentCycles - SetupStartCycles) : -1.0;
+}
+
+double FCustomMoviePlayer::GetLoadingThreadCPUTime() const
+{
+	check(IsInGameThread());
+	return SyncMechanism && !SyncMechanism->IsSlateThreadArmed() ? SyncMechanism->GetLastRunCPUTime() : -1.0;
+}
+
+void FCustomMoviePlayer::PresentFirstFrameOnGameThread()
+{
+	check(IsInGameThread());
+	ASYNC_LOADING_SCREEN_TRACE_SCOPE(PresentFirstFrameOnGameThread);
+
+	if (!FSlateApplication::IsInitialized() || (GDynamicRHI && GDynamicRHI->RHIIsRenderingSuspended()))
+	{
+		return;
+	}
+
+	// The slate loading thread is parked until Initialize, the widget renderer is ours until then
+	WidgetRenderer->DrawWindow(0.0f);
+	bFirstFramePresentedOnGameThread = true;
+
+	FCustomMoviePlayer* InMoviePlayer = this;
+	ENQUEUE_RENDER_COMMAND(PresentFirstLoadingScreenFrame)(
+		[InMoviePlayer](FRHICommandListImmediate& RHICmdList)
+		{
+			GFrameNumberRenderThread++;
+			GRHICommandList.GetImmediateCommandList().BeginFrame();
+			InMoviePlayer->TickStreamer(0.0f);
+			GRHICommandList.GetImmediateCommandList().EndFrame();
+			InMoviePlayer->FlushRHIForLoadingFrame(GRHICommandList.GetImmediateCommandList());
+			InMoviePlayer->OnFirstFramePresented();
+		});
+
+	// The loading screen is on screen before the game thread goes back to loading
+	FlushRenderingCommands();
+}
+
+void FCustomMoviePlayer::OnFirstFramePresented()
+{
+	check(IsInRenderingThread());
+
+	const uint64 PresentCycles = FPlatformTime::Cycles64();
+	FirstPresentCycles = PresentCycles;
+
+	const double TimeToFirstFrame = FPlatformTime::ToMilliseconds64(PresentCycles - SetupStartCycles);
+	CSV_CUSTOM_STAT(AsyncLoadingScreen, TimeToFirstFrame, TimeToFirstFrame, ECsvCustomStatOp::Set);
+
+	if (bFirstFramePresentedOnGameThread)
+	{
+		UE_LOG(LogMoviePlayer, Log, TEXT("Loading screen '%s' presented its first frame %.1f ms after its setup: widgets built in %.1f ms, playback started at %.1f ms, painted and presented on the game thread"),
+			*FirstFrameScreenName.ToString(), TimeToFirstFrame, FPlatformTime::ToMilliseconds64(SetupEndCycles - SetupStartCycles), FPlatformTime::ToMilliseconds64(PlayCycles - SetupStartCycles));
+	}
+	else
+	{
+		UE_LOG(LogMoviePlayer, Log, TEXT("Loading screen '%s' presented its first frame %.1f ms after its setup: widgets built in %.1f ms, playback started at %.1f ms, loading thread armed at %.1f ms, first paint done at %.1f ms"),
+			*FirstFrameScreenName.ToString(), TimeToFirstFrame, FPlatformTime::ToMilliseconds64(SetupEndCycles - SetupStartCycles), FPlatformTime::ToMilliseconds64(PlayCycles - SetupStartCycles),
+			FPlatformTime::ToMilliseconds64(ArmedCycles - SetupStartCycles), FPlatformTime::ToMilliseconds64(WidgetRenderer->GetFirstPaintCycles() - SetupStartCycles));
+	}
+}
+
+void FCustomMoviePlayer::FlushRHIForLoadingFrame(FRHICommandListImmediate& RHICmdList)
+{
+	check(IsInRenderingThread());
+
+	ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(RHIFlush);
+
+	bool bFlushResources = true;
+	switch (RHIFlushPolicy_RenderThread)
+	{
+	case ELoadingScreenRHIFlushPolicy::LSFP_Periodic:
+		bFlushResources = NumLoadingFrames_RenderThread % RHIFlushInterval_RenderThread == 0;
+		break;
+	case ELoadingScreenRHIFlushPolicy::LSFP_OnScreenChange:
+		bFlushResources = NumLoadingFrames_RenderThread == 0;
+		break;
+	default:
+		break;
+	}
+	++NumLoadingFrames_RenderThread;
+
+	// The other frames still have to reach the RHI thread, they just don't wait on its resource deletions
+	RHICmdList.ImmediateFlush(bFlushResources ? EImmediateFlushType::FlushRHIThreadFlushResources : EImmediateFlushType::DispatchToRHIThread);
+}
+
 void FCustomMoviePlayer::TickStreamer(float DeltaTime)
 {	
 	if (MovieStreamingIsPrepared() && ActiveMovieStreamer.IsValid() && !IsMovieStreamingFinished())
 	{
+		ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(TickStreamer);
+
 		const bool bMovieIsDone = ActiveMovieStreamer->Tick(DeltaTime);
 		if (bMovieIsDone)
 		{
@@ -676,12 +920,43 @@ void FCustomMoviePlayer::TickStreamer(float DeltaTime)
 
 TStatId FCustomMoviePlayer::GetStatId() const
 {
-	RETURN_QUICK_DECLARE_CYCLE_STAT(FCustomMoviePlayer, STATGROUP_Tickables);
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FCustomMoviePlayer, STATGROUP_AsyncLoadingScreen);
 }
 
 bool FCustomMoviePlayer::IsTickable() const
 {
-	return true;
+	// Nothing to do per render thread frame, see Tick
+	return false;
+}
+
+void FCustomMoviePlayer::SetTickableRegistered(bool bRegistered)
+{
+	check(IsInGameThread());
+
+	if (bRegistered == bTickableRegistered)
+	{
+		return;
+	}
+
+	bTickableRegistered = bRegistered;
+
+	FCustomMoviePlayer* InMoviePlayer = this;
+	if (bRegistered)
+	{
+		ENQUEUE_RENDER_COMMAND(RegisterMoviePlayerTickable)(
+			[InMoviePlayer](FRHICommandListImmediate& RHICmdList)
+			{
+				InMoviePlayer->Register();
+			});
+	}
+	else
+	{
+		ENQUEUE_RENDER_COMMAND(UnregisterMoviePlayerTickable)(
+			[InMoviePlayer](FRHICommandListImmediate& RHICmdList)
+			{
+				InMoviePlayer->Unregister();
+			});
+	}
 }
 
 bool FCustomMoviePlayer::LoadingScreenIsPrepared() const
@@ -868,7 +1143,16 @@ bool FCustomMoviePlayer::IsLastMovieInPlaylist()
 }
 
 FCustomMoviePlayerWidgetRenderer::FCustomMoviePlayerWidgetRenderer(TSharedPtr<SWindow> InMainWindow, TSharedPtr<SVirtualWindow> InVirtualRenderWindow, FSlateRenderer* InRenderer)
-	: MainWindow(InMainWindow.Get())
+	: NumPaints(0)
+	, SumDrawElements(0)
+	, SumPaintTime(0.0)
+	, FirstPaintTime(0.0)
+	, FirstPaintCycles(0)
+	, bTracksRedraw(false)
+	, LastDrawTime(0.0)
+	, LastDrawSize(FVector2D::ZeroVector)
+	, NumForcedRedraws(0)
+	, MainWindow(InMainWindow.Get())
 	, VirtualRenderWindow(InVirtualRenderWindow.ToSharedRef())
 	, SlateRenderer(InRenderer)
 {
@@ -884,11 +1168,22 @@ void FCustomMoviePlayerWidgetRenderer::DrawWindow(float DeltaTime)
 		return;
 	}
 
-	FSlateApplication::Get().Tick(ESlateTickType::Time);
+	ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(DrawWindow);
+
+	{
+		ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(SlateTick);
+		FSlateApplication::Get().Tick(ESlateTickType::Time);
+	}
+
+	LastDrawTime = FPlatformTime::Seconds();
+	NumForcedRedraws = FMath::Max(NumForcedRedraws - 1, 0);
 
 	FGeometry WindowGeometry = VirtualRenderWindow->GetPaintSpaceGeometry();
 
-	VirtualRenderWindow->SlatePrepass(WindowGeometry.Scale);
+	{
+		ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(SlatePrepass);
+		VirtualRenderWindow->SlatePrepass(WindowGeometry.Scale);
+	}
 
 	FSlateRect ClipRect = WindowGeometry.GetLayoutBoundingRect();
 
@@ -906,6 +1201,9 @@ void FCustomMoviePlayerWidgetRenderer::DrawWindow(float DeltaTime)
 
 	int32 MaxLayerId = 0;
 	{
+		ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(Paint);
+		const uint64 PaintStartCycles = FPlatformTime::Cycles64();
+
 		FPaintArgs PaintArgs(nullptr, *HittestGrid, FVector2D::ZeroVector, FSlateApplication::Get().GetCurrentTime(), FSlateApplication::Get().GetDeltaTime());
 
 		// Paint the window
@@ -916,10 +1214,27 @@ void FCustomMoviePlayerWidgetRenderer::DrawWindow(float DeltaTime)
 			0,
 			FWidgetStyle(),
 			VirtualRenderWindow->IsEnabled());
+
+		// Cached layers are not part of the uncached elements, this is what was rebuilt this frame
+		const int32 NumDrawElements = WindowElementList.GetUncachedDrawElements().Num();
+		SET_DWORD_STAT(STAT_AsyncLoadingScreen_NumDrawElements, NumDrawElements);
+		CSV_CUSTOM_STAT(AsyncLoadingScreen, NumDrawElements, NumDrawElements, ECsvCustomStatOp::Set);
+
+		const double PaintTime = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - PaintStartCycles);
+		if (NumPaints == 0)
+		{
+			FirstPaintTime = PaintTime;
+		}
+
+		++NumPaints;
+		SumDrawElements += NumDrawElements;
+		SumPaintTime += PaintTime;
 	}
 
 	if (GEngine->GameViewport->GetIsUsingSoftwareCursorWidgets())
 	{
+		ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(CursorPaint);
+
 		if (TSharedPtr<SWidget> cursor_widget{GEngine->GameViewport->GetSoftwareCursorWidget(EMouseCursor::Default)})
 		{
 			// Draw Software Cursors
@@ -947,11 +1262,110 @@ void FCustomMoviePlayerWidgetRenderer::DrawWindow(float DeltaTime)
 		}
 	}
 
-	SlateRenderer->DrawWindows(DrawBuffer);
+	{
+		ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(DrawWindows);
+		SlateRenderer->DrawWindows(DrawBuffer);
+	}
+
+	if (FirstPaintCycles.Load() == 0)
+	{
+		FirstPaintCycles = FPlatformTime::Cycles64();
+	}
 
 	DrawBuffer.ViewOffset = FVector2D::ZeroVector;
 }
 
+bool FCustomMoviePlayerWidgetRenderer::IsMainWindowInBackground() const
+{
+	return !FPlatformApplicationMisc::IsThisApplicationForeground() || MainWindow->IsWindowMinimized();
+}
+
+void FCustomMoviePlayerWidgetRenderer::GatherRedrawMetaData(const TSharedPtr<SWidget>& Content)
+{
+	check(IsInGameThread());
+
+	RedrawMetaData.Reset();
+	bTracksRedraw = Content.IsValid() && Content->GetMetaData<FLoadingScreenRedrawMetaData>().IsValid();
+	if (bTracksRedraw)
+	{
+		GatherRedrawMetaData_Recursive(*Content);
+	}
+
+	LastDrawTime = 0.0;
+	NumForcedRedraws = 0;
+
+	NumPaints = 0;
+	SumDrawElements = 0;
+	SumPaintTime = 0.0;
+	FirstPaintTime = 0.0;
+	FirstPaintCycles = 0;
+}
+
+void FCustomMoviePlayerWidgetRenderer::LogPaintStats() const
+{
+	if (NumPaints > 0)
+	{
+		UE_LOG(LogMoviePlayer, Verbose, TEXT("Loading thread painted %d frames: %.1f draw elements rebuilt and %.3f ms paint time per frame on average"),
+			NumPaints, (double)SumDrawElements / NumPaints, SumPaintTime * 1000.0 / NumPaints);
+	}
+
+	if (NumPaints > 1)
+	{
+		// The first paint lays out the text and uploads the glyphs not rasterized yet, see FLoadingScreenTextPrewarm
+		const double SteadyPaintTime = (SumPaintTime - FirstPaintTime) / (NumPaints - 1);
+		UE_LOG(LogMoviePlayer, Verbose, TEXT("Loading thread first paint took %.3f ms against %.3f ms per frame afterwards%s"),
+			FirstPaintTime * 1000.0, SteadyPaintTime * 1000.0, FirstPaintTime > 2.0 * SteadyPaintTime ? TEXT(", the first frame hitched") : TEXT(""));
+	}
+}
+
+void FCustomMoviePlayerWidgetRenderer::GatherRedrawMetaData_Recursive(SWidget& Widget)
+{
+	TSharedPtr<FLoadingScreenRedrawMetaData> WidgetRedrawMetaData = Widget.GetMetaData<FLoadingScreenRedrawMetaData>();
+	if (WidgetRedrawMetaData.IsValid() && WidgetRedrawMetaData->GetNextPaintTime.IsBound())
+	{
+		RedrawMetaData.Add(WidgetRedrawMetaData.ToSharedRef());
+	}
+
+	FChildren* Children = Widget.GetAllChildren();
+	for (int32 ChildIndex = 0; ChildIndex < Children->Num(); ++ChildIndex)
+	{
+		GatherRedrawMetaData_Recursive(Children->GetChildAt(ChildIndex).Get());
+	}
+}
+
+double FCustomMoviePlayerWidgetRenderer::GetNextRedrawTime(double CurrentTime, double KeepAliveInterval)
+{
+	// Software cursors follow the mouse, we can't tell when they move
+	if (!bTracksRedraw || LastDrawTime == 0.0 || (GEngine->GameViewport && GEngine->GameViewport->GetIsUsingSoftwareCursorWidgets()))
+	{
+		return CurrentTime;
+	}
+
+	const FVector2D DrawSize = VirtualRenderWindow->GetViewportSize();
+	if (DrawSize != LastDrawSize)
+	{
+		LastDrawSize = DrawSize;
+		NumForcedRedraws = 2;
+	}
+
+	if (NumForcedRedraws > 0)
+	{
+		return CurrentTime;
+	}
+
+	double NextRedrawTime = LastDrawTime + KeepAliveInterval;
+	for (const TSharedRef<FLoadingScreenRedrawMetaData>& WidgetRedrawMetaData : RedrawMetaData)
+	{
+		// Every widget has to be queried, they track their own visibility changes in there
+		if (WidgetRedrawMetaData->GetNextPaintTime.IsBound())
+		{
+			NextRedrawTime = FMath::Min(NextRedrawTime, WidgetRedrawMetaData->GetNextPaintTime.Execute(CurrentTime));
+		}
+	}
+
+	return NextRedrawTime;
+}
+
 float FCustomMoviePlayer::GetViewportDPIScale() const
 {
 	return 1.f;
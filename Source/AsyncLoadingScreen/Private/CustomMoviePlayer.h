@@ -15,8 +15,12 @@
 
 #include "Misc/CoreDelegates.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogMoviePlayer, Log, All);
+
 class FWidgetRenderer;
 class SVirtualWindow;
+class FLoadingScreenRedrawMetaData;
+enum class ELoadingScreenRHIFlushPolicy : uint8;
 
 class FCustomMoviePlayerWidgetRenderer
 {
@@ -25,7 +29,44 @@ public:
 
 	void DrawWindow(float DeltaTime);
 
+	/**
+	 * Collects the FLoadingScreenRedrawMetaData of the loading screen content, called on the game thread before the slate thread is armed.
+	 * Content without it on its root widget is always repainted.
+	 */
+	void GatherRedrawMetaData(const TSharedPtr<SWidget>& Content);
+
+	/** Logs the average paint cost since the last GatherRedrawMetaData. Called on the slate thread */
+	void LogPaintStats() const;
+
+	/** Cycle count the first paint since the last GatherRedrawMetaData finished at, 0 until then. Can be called from any thread */
+	uint64 GetFirstPaintCycles() const { return FirstPaintCycles.Load(); }
+
+	/** True if the game window is minimized or another application has the focus. Called on the slate thread */
+	bool IsMainWindowInBackground() const;
+
+	/** Next time the loading screen has to be repainted at, never later than KeepAliveInterval after the last paint. Called on the slate thread */
+	double GetNextRedrawTime(double CurrentTime, double KeepAliveInterval);
+
 private:
+	void GatherRedrawMetaData_Recursive(SWidget& Widget);
+
+	/** Paint statistics of the current loading screen */
+	int32 NumPaints;
+	int64 SumDrawElements;
+	double SumPaintTime;
+	double FirstPaintTime;
+	TAtomic<uint64> FirstPaintCycles;
+
+	/** Redraw metadata of the animated widgets of the current loading screen */
+	TArray<TSharedRef<FLoadingScreenRedrawMetaData>> RedrawMetaData;
+	/** True if every animated widget of the current loading screen reports when it has to be repainted */
+	bool bTracksRedraw;
+	/** Time and window size of the last paint, repainting is always needed after a resize */
+	double LastDrawTime;
+	FVector2D LastDrawSize;
+	/** Number of upcoming frames that are repainted regardless, layouts only pick up a new size one frame after it changed */
+	int32 NumForcedRedraws;
+
 	/** The actual window content will be drawn to */
 	/** Note: This is raw as we SWindows registered with SlateApplication are not thread safe */
 	SWindow* MainWindow;
@@ -90,6 +131,53 @@ public:
 	virtual void Tick( float DeltaTime ) override;
 	virtual TStatId GetStatId() const override;
 	virtual bool IsTickable() const override;
+
+	/** Registers or unregisters the render thread tickable while a loading screen is playing, draw passes don't rely on it being ticked */
+	void SetTickableRegistered(bool bRegistered);
+
+	/** Sets how often the frames of the next loading screen flush the RHI thread resources, restarting the frame count */
+	void SetRHIFlushPolicy(ELoadingScreenRHIFlushPolicy InRHIFlushPolicy, int32 InRHIFlushInterval);
+
+	/**
+	 * Starts measuring the time to first frame of the next loading screen, called before its widgets are built.
+	 * ScreenName is its settings name, see UAsyncLoadingScreenLibrary::GetLoadingScreenSettingsByName
+	 */
+	void BeginFirstFrameMeasurement(const FName& ScreenName);
+
+	/** Seconds from the setup of the last loading screen to its first frame being presented, negative until it was */
+	double GetTimeToFirstFrame() const;
+
+	/** CPU time in seconds the loading thread used for the last loading screen, once stopped. Negative if unknown */
+	double GetLoadingThreadCPUTime() const;
+
+private:
+	/** Paints the first frame of the loading screen and waits until the render thread presented it, before the slate loading thread is armed */
+	void PresentFirstFrameOnGameThread();
+
+	/** Records and logs the time to first frame once the first frame of the loading screen is presented, runs on the render thread */
+	void OnFirstFramePresented();
+
+	/** Steps of the time to first frame of the current loading screen, as cycle counts. Written on the game thread before the slate loading thread is armed */
+	FName FirstFrameScreenName;
+	uint64 SetupStartCycles;
+	uint64 SetupEndCycles;
+	uint64 PlayCycles;
+	uint64 ArmedCycles;
+	bool bFirstFrameMeasurementBegun;
+	bool bFirstFramePresentedOnGameThread;
+
+	/** Cycle count the first frame was presented at, written on the render thread, 0 until then */
+	TAtomic<uint64> FirstPresentCycles;
+
+	/** Ends a loading screen frame on the render thread, flushing the RHI as the flush policy says */
+	void FlushRHIForLoadingFrame(FRHICommandListImmediate& RHICmdList);
+
+	/** Render thread copies of the flush policy and number of frames flushed with it */
+	ELoadingScreenRHIFlushPolicy RHIFlushPolicy_RenderThread;
+	int32 RHIFlushInterval_RenderThread;
+	int32 NumLoadingFrames_RenderThread;
+
+public:
 	
 	/** Callback for clicking on the viewport */
 	FReply OnLoadingScreenMouseButtonDown(const FGeometry& Geometry, const FPointerEvent& PointerEvent);
@@ -115,6 +203,9 @@ private:
 	/** Ticks the underlying MovieStreamer.  Must be done exactly once before each DrawWindows call. */
 	void TickStreamer(float DeltaTime);
 
+	/** Finishes the frame of the draw pass enqueued by the slate loading thread, runs on the render thread */
+	void ConsumeSlateDrawPass(float DeltaTime);
+
 	/** True if we have both a registered movie streamer and movies to stream */
 	bool MovieStreamingIsPrepared() const;
 
@@ -192,6 +283,9 @@ private:
 	/** True if the movie player has been initialized */
 	bool bInitialized;
 
+	/** True while the render thread tickable is registered, i.e. while a loading screen is playing. Game thread only */
+	bool bTickableRegistered;
+
 	/** Critical section to allow the slate loading thread and the render thread to safely utilize the synchronization mechanism for ticking Slate. */
 	FCriticalSection SyncMechanismCriticalSection;
 
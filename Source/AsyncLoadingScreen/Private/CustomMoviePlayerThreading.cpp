@@ -6,16 +6,147 @@
 #include "Framework/Application/SlateApplication.h"
 #include "CustomMoviePlayer.h"
 #include "HAL/PlatformApplicationMisc.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/Event.h"
+#include "RenderingThread.h"
+#include "LoadingScreenSettings.h"
+#include "AsyncLoadingScreenStats.h"
+#include "AsyncLoadingScreenTrace.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/WindowsHWrapper.h"
+#elif PLATFORM_UNIX || PLATFORM_MAC
+#include <time.h>
+#endif
 
 FThreadSafeCounter FCustomSlateLoadingSynchronizationMechanism::LoadingThreadInstanceCounter;
 
+static TAutoConsoleVariable<float> CVarAsyncLoadingScreenTargetFrameRate(
+	TEXT("AsyncLoadingScreen.TargetFrameRate"),
+	0.0f,
+	TEXT("Frame rate the custom loading screen thread paints at.\n")
+	TEXT("<= 0: use Performance.TargetFrameRate from the project settings (default)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAsyncLoadingScreenFrameSpinThreshold(
+	TEXT("AsyncLoadingScreen.FrameSpinThresholdMs"),
+	0.5f,
+	TEXT("Time in milliseconds before each frame deadline during which the loading screen thread spins instead of sleeping.\n")
+	TEXT("Frame time error stays within this bound as long as the OS wakes the thread up within that window."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAsyncLoadingScreenDrawPassPipelineDepth(
+	TEXT("AsyncLoadingScreen.DrawPassPipelineDepth"),
+	0,
+	TEXT("Number of draw passes the custom loading screen thread may paint ahead of the render thread (1-3).\n")
+	TEXT("<= 0: use Performance.DrawPassPipelineDepth from the project settings (default)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAsyncLoadingScreenThreadShutdownTimeout(
+	TEXT("AsyncLoadingScreen.ThreadShutdownTimeout"),
+	0.0f,
+	TEXT("Time in seconds the game thread waits for the custom loading screen thread to stop before logging a warning.\n")
+	TEXT("<= 0: use Performance.ThreadShutdownTimeout from the project settings (default)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAsyncLoadingScreenThreadPriority(
+	TEXT("AsyncLoadingScreen.ThreadPriority"),
+	-1,
+	TEXT("Priority of the custom loading screen thread, as an EThreadPriority value (0: Normal, 1: Above Normal, 2: Below Normal, 3: Highest, 4: Lowest, 5: Slightly Below Normal, 6: Time Critical).\n")
+	TEXT("< 0: use Performance.ThreadPriority from the project settings (default)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<FString> CVarAsyncLoadingScreenThreadAffinityMask(
+	TEXT("AsyncLoadingScreen.ThreadAffinityMask"),
+	TEXT(""),
+	TEXT("Mask of the cores the custom loading screen thread may run on, decimal or hexadecimal (e.g. 0x8).\n")
+	TEXT("Empty: use Performance.ThreadAffinityMask from the project settings (default)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAsyncLoadingScreenThreadStackSize(
+	TEXT("AsyncLoadingScreen.ThreadStackSizeKB"),
+	-1,
+	TEXT("Stack size in KB of the custom loading screen thread, 0 uses the platform default. Only applied when the thread is created.\n")
+	TEXT("< 0: use Performance.ThreadStackSizeKB from the project settings (default)"),
+	ECVF_Default);
+
+static EThreadPriority GetLoadingScreenThreadPriority()
+{
+	const int32 PriorityOverride = CVarAsyncLoadingScreenThreadPriority.GetValueOnGameThread();
+	if (PriorityOverride >= 0 && PriorityOverride < TPri_Num)
+	{
+		return (EThreadPriority)PriorityOverride;
+	}
+
+	switch (GetDefault<ULoadingScreenSettings>()->Performance.ThreadPriority)
+	{
+	case ELoadingScreenThreadPriority::LSTP_AboveNormal:
+		return TPri_AboveNormal;
+	case ELoadingScreenThreadPriority::LSTP_BelowNormal:
+		return TPri_BelowNormal;
+	case ELoadingScreenThreadPriority::LSTP_SlightlyBelowNormal:
+		return TPri_SlightlyBelowNormal;
+	case ELoadingScreenThreadPriority::LSTP_Lowest:
+		return TPri_Lowest;
+	case ELoadingScreenThreadPriority::LSTP_Highest:
+		return TPri_Highest;
+	case ELoadingScreenThreadPriority::LSTP_TimeCritical:
+		return TPri_TimeCritical;
+	default:
+		return TPri_Normal;
+	}
+}
+
+static uint64 GetLoadingScreenThreadAffinityMask()
+{
+	const FString AffinityMaskOverride = CVarAsyncLoadingScreenThreadAffinityMask.GetValueOnGameThread().TrimStartAndEnd();
+	const uint64 AffinityMask = AffinityMaskOverride.IsEmpty()
+		? (uint64)GetDefault<ULoadingScreenSettings>()->Performance.ThreadAffinityMask
+		: FCString::Strtoui64(*AffinityMaskOverride, nullptr, 0);
+
+	return AffinityMask != 0 ? AffinityMask : FPlatformAffinity::GetNoAffinityMask();
+}
+
+static uint32 GetLoadingScreenThreadStackSize()
+{
+	const int32 StackSizeOverride = CVarAsyncLoadingScreenThreadStackSize.GetValueOnGameThread();
+	return FMath::Max(StackSizeOverride >= 0 ? StackSizeOverride : GetDefault<ULoadingScreenSettings>()->Performance.ThreadStackSizeKB, 0) * 1024;
+}
+
+static TAutoConsoleVariable<int32> CVarAsyncLoadingScreenSkipUnchangedFrames(
+	TEXT("AsyncLoadingScreen.SkipUnchangedFrames"),
+	-1,
+	TEXT("Skip painting the custom loading screen when nothing on it changed.\n")
+	TEXT("< 0: use Performance.bSkipUnchangedFrames from the project settings (default), 0: always paint, 1: skip unchanged frames"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAsyncLoadingScreenRedrawKeepAliveInterval(
+	TEXT("AsyncLoadingScreen.RedrawKeepAliveInterval"),
+	-1.0f,
+	TEXT("Time in seconds after which an unchanged custom loading screen is repainted anyway.\n")
+	TEXT("< 0: use Performance.RedrawKeepAliveInterval from the project settings (default)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAsyncLoadingScreenBackgroundFrameRate(
+	TEXT("AsyncLoadingScreen.BackgroundFrameRate"),
+	-1.0f,
+	TEXT("Frame rate of the custom loading screen thread while the game window is minimized or unfocused, 0 pauses painting.\n")
+	TEXT("< 0: use Performance.BackgroundFrameRate from the project settings (default), or don't throttle if Performance.bThrottleInBackground is off"),
+	ECVF_Default);
+
+/** How often the window state is checked while painting is throttled, so the full rate resumes quickly */
+static const double BackgroundPollInterval = 0.05;
+
+/** Keep the memory bounded on very long loads, the first samples are representative enough */
+static const int32 MaxNumDrawPassHandoffLatencySamples = 8192;
+
 /**
  * The Slate thread is simply run on a worker thread.
  * Slate is run on another thread because the game thread (where Slate is usually run)
  * is blocked loading things. Slate is very modular, which makes it very easy to run on another
  * thread with no adverse effects.
- * It does not enqueue render commands, because the RHI is not thread safe. Thus, it waits to
- * enqueue render commands until the render thread tickables ticks, and then it calls them there.
+ * Once a draw pass is painted, it enqueues a render command behind the Slate draw commands of that pass,
+ * which consumes the pass on the render thread (see FConsumeSlateDrawPassDelegate).
  */
 class FCustomSlateLoadingThreadTask : public FRunnable
 {
@@ -36,49 +167,299 @@ private:
 
 
 
+FCustomSlateLoadingFramePacer::FCustomSlateLoadingFramePacer()
+	: bSkippedFrames(false)
+	, InterruptEvent(FPlatformProcess::GetSynchEventFromPool(true))
+	, bInterrupted(false)
+{
+	Reset(60.0f, 0.0f);
+}
+
+FCustomSlateLoadingFramePacer::~FCustomSlateLoadingFramePacer()
+{
+	FPlatformProcess::ReturnSynchEventToPool(InterruptEvent);
+	InterruptEvent = nullptr;
+}
+
+void FCustomSlateLoadingFramePacer::Reset(float InTargetFrameRate, float InSpinThresholdSeconds)
+{
+	TargetFrameTime = 1.0 / FMath::Max(InTargetFrameRate, 1.0f);
+	SpinThreshold = FMath::Clamp<double>(InSpinThresholdSeconds, 0.0, TargetFrameTime);
+
+	LastFrameTime = FPlatformTime::Seconds();
+	NextDeadline = LastFrameTime;
+
+	NumFrames = 0;
+	NumMissedDeadlines = 0;
+	SumFrameTime = 0.0;
+	SumFrameTimeSquared = 0.0;
+	MaxFrameTimeError = 0.0;
+
+	bSkippedFrames = false;
+	bInterrupted = false;
+	InterruptEvent->Reset();
+}
+
+void FCustomSlateLoadingFramePacer::SkipUntil(double Time)
+{
+	if (Time > NextDeadline)
+	{
+		NextDeadline = Time;
+		bSkippedFrames = true;
+	}
+}
+
+void FCustomSlateLoadingFramePacer::Interrupt()
+{
+	bInterrupted = true;
+	InterruptEvent->Trigger();
+}
+
+double FCustomSlateLoadingFramePacer::WaitForNextFrame()
+{
+	double CurrentTime = FPlatformTime::Seconds();
+
+	// Sleep coarsely, the OS may wake us up late so stop short of the deadline.
+	// Waiting on the event rather than sleeping lets a shutdown request cut the frame short
+	const double TimeToSleep = NextDeadline - CurrentTime - SpinThreshold;
+	if (TimeToSleep > 0.0 && !bInterrupted)
+	{
+		InterruptEvent->Wait(FTimespan::FromSeconds(TimeToSleep), true);
+	}
+
+	// Spin for the remainder
+	while ((CurrentTime = FPlatformTime::Seconds()) < NextDeadline && !bInterrupted)
+	{
+		FPlatformProcess::YieldThread();
+	}
+
+	const double DeltaTime = CurrentTime - LastFrameTime;
+	LastFrameTime = CurrentTime;
+
+	// Schedule against the absolute deadline so that late wake ups don't accumulate
+	NextDeadline += TargetFrameTime;
+	if (NextDeadline <= CurrentTime)
+	{
+		// We fell behind by more than a whole frame (long draw or hitch), resync instead of bursting frames to catch up
+		NextDeadline = CurrentTime + TargetFrameTime;
+		++NumMissedDeadlines;
+	}
+
+	// The first frame is due immediately so it has no meaningful interval, neither have the ones after skipped frames
+	if (NumFrames++ > 0 && !bSkippedFrames)
+	{
+		SumFrameTime += DeltaTime;
+		SumFrameTimeSquared += DeltaTime * DeltaTime;
+		MaxFrameTimeError = FMath::Max(MaxFrameTimeError, FMath::Abs(DeltaTime - TargetFrameTime));
+	}
+
+	bSkippedFrames = false;
+
+	return DeltaTime;
+}
+
+double FCustomSlateLoadingFramePacer::GetAverageFrameTime() const
+{
+	return NumFrames > 1 ? SumFrameTime / (NumFrames - 1) : 0.0;
+}
+
+double FCustomSlateLoadingFramePacer::GetFrameTimeJitter() const
+{
+	if (NumFrames > 1)
+	{
+		const double Average = GetAverageFrameTime();
+		return FMath::Sqrt(FMath::Max(SumFrameTimeSquared / (NumFrames - 1) - Average * Average, 0.0));
+	}
+	return 0.0;
+}
+
 FCustomSlateLoadingSynchronizationMechanism::FCustomSlateLoadingSynchronizationMechanism(
 	TSharedPtr<FCustomMoviePlayerWidgetRenderer, ESPMode::ThreadSafe> InWidgetRenderer, 
-	const TSharedPtr<IMovieStreamer, ESPMode::ThreadSafe>& InMovieStreamer)
-	: WidgetRenderer(InWidgetRenderer)
-	, MovieStreamer(InMovieStreamer)
+	const FConsumeSlateDrawPassDelegate& InConsumeDrawPassDelegate)
+	: DrawPassPipelineDepth(1)
+	, NumDrawPassesEnqueued(0)
+	, NumDrawPassesConsumed(0)
+	, NumSlateThreadStalls(0)
+	, NumRenderThreadStalls(0)
+	, SlateLoadingThreadWakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+	, SlateLoadingThreadArmEvent(FPlatformProcess::GetSynchEventFromPool(false))
+	, SlateLoadingThreadParkedEvent(FPlatformProcess::GetSynchEventFromPool(false))
+	, ShutdownTimeout(1.0f)
+	, ThreadPriority(TPri_Normal)
+	, ThreadAffinityMask(FPlatformAffinity::GetNoAffinityMask())
+	, bSlateThreadArmed(false)
+	, bSlateThreadExitRequested(false)
+	, ArmGeneration(0)
+	, ConsumedArmGeneration(0)
+	, ArmCycles(0)
+	, bWarmStart(false)
+	, bSkipUnchangedFrames(false)
+	, RedrawKeepAliveInterval(0.5f)
+	, NumSkippedFrames(0)
+	, BackgroundFrameRate(-1.0f)
+	, bThrottled(false)
+	, NumThrottledFrames(0)
+	, LastPaintTime(0.0)
+	, LastRunCPUTime(-1.0)
+	, TargetFrameRate(60.0f)
+	, SlateLoadingThread(nullptr)
+	, SlateRunnableTask(nullptr)
+	, WidgetRenderer(InWidgetRenderer)
+	, ConsumeDrawPassDelegate(InConsumeDrawPassDelegate)
 {
 }
 
 FCustomSlateLoadingSynchronizationMechanism::~FCustomSlateLoadingSynchronizationMechanism()
 {
 	DestroySlateThread();
+
+	FPlatformProcess::ReturnSynchEventToPool(SlateLoadingThreadWakeEvent);
+	SlateLoadingThreadWakeEvent = nullptr;
+	FPlatformProcess::ReturnSynchEventToPool(SlateLoadingThreadArmEvent);
+	SlateLoadingThreadArmEvent = nullptr;
+	FPlatformProcess::ReturnSynchEventToPool(SlateLoadingThreadParkedEvent);
+	SlateLoadingThreadParkedEvent = nullptr;
 }
 
-void FCustomSlateLoadingSynchronizationMechanism::Initialize()
+void FCustomSlateLoadingSynchronizationMechanism::Initialize(const TSharedPtr<IMovieStreamer, ESPMode::ThreadSafe>& InMovieStreamer)
 {
 	check(IsInGameThread());
+	ASYNC_LOADING_SCREEN_TRACE_SCOPE(InitializeSyncMechanism);
+
+	// Never re-arm a thread that is still running the previous main loop
+	check(!bSlateThreadArmed);
+
+	ArmCycles = FPlatformTime::Cycles64();
+	bWarmStart = SlateLoadingThread != nullptr;
+
+	// The thread is parked, nothing reads these until it is armed again
+	MovieStreamer = InMovieStreamer;
+
+	const int32 DrawPassPipelineDepthOverride = CVarAsyncLoadingScreenDrawPassPipelineDepth.GetValueOnGameThread();
+	DrawPassPipelineDepth = FMath::Clamp(DrawPassPipelineDepthOverride > 0 ? DrawPassPipelineDepthOverride : GetDefault<ULoadingScreenSettings>()->Performance.DrawPassPipelineDepth, 1, MaxDrawPassPipelineDepth);
+
+	// Draw passes the last run stopped waiting for are still queued on the render thread, let it consume them against the counters they were enqueued with
+	if (IsSlateDrawPassEnqueued())
+	{
+		FlushRenderingCommands();
+	}
 
 	ResetSlateDrawPassEnqueued();
 	SetSlateMainLoopRunning();
 
 	bMainLoopRunning = true;
 
-	FString ThreadName = TEXT("CustomSlateLoadingThread");
-	ThreadName.AppendInt(LoadingThreadInstanceCounter.Increment());
+	const float TargetFrameRateOverride = CVarAsyncLoadingScreenTargetFrameRate.GetValueOnGameThread();
+	TargetFrameRate = TargetFrameRateOverride > 0.0f ? TargetFrameRateOverride : GetDefault<ULoadingScreenSettings>()->Performance.TargetFrameRate;
 
-	SlateRunnableTask = new FCustomSlateLoadingThreadTask( *this );
-	SlateLoadingThread = FRunnableThread::Create(SlateRunnableTask, *ThreadName);
+	const int32 SkipUnchangedFramesOverride = CVarAsyncLoadingScreenSkipUnchangedFrames.GetValueOnGameThread();
+	bSkipUnchangedFrames = SkipUnchangedFramesOverride >= 0 ? SkipUnchangedFramesOverride != 0 : GetDefault<ULoadingScreenSettings>()->Performance.bSkipUnchangedFrames;
+
+	const float RedrawKeepAliveIntervalOverride = CVarAsyncLoadingScreenRedrawKeepAliveInterval.GetValueOnGameThread();
+	RedrawKeepAliveInterval = RedrawKeepAliveIntervalOverride >= 0.0f ? RedrawKeepAliveIntervalOverride : GetDefault<ULoadingScreenSettings>()->Performance.RedrawKeepAliveInterval;
+
+	const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+	const float BackgroundFrameRateOverride = CVarAsyncLoadingScreenBackgroundFrameRate.GetValueOnGameThread();
+	BackgroundFrameRate = BackgroundFrameRateOverride >= 0.0f ? BackgroundFrameRateOverride : (Settings->Performance.bThrottleInBackground ? Settings->Performance.BackgroundFrameRate : -1.0f);
+
+	const float ShutdownTimeoutOverride = CVarAsyncLoadingScreenThreadShutdownTimeout.GetValueOnGameThread();
+	ShutdownTimeout = ShutdownTimeoutOverride > 0.0f ? ShutdownTimeoutOverride : GetDefault<ULoadingScreenSettings>()->Performance.ThreadShutdownTimeout;
+
+	ThreadPriority = GetLoadingScreenThreadPriority();
+	ThreadAffinityMask = GetLoadingScreenThreadAffinityMask();
+
+	SlateLoadingThreadParkedEvent->Reset();
+	bSlateThreadArmed = true;
+	++ArmGeneration;
+
+	if (SlateLoadingThread == nullptr)
+	{
+		FString ThreadName = TEXT("CustomSlateLoadingThread");
+		ThreadName.AppendInt(LoadingThreadInstanceCounter.Increment());
+
+		const uint32 ThreadStackSize = GetLoadingScreenThreadStackSize();
+
+		bSlateThreadExitRequested = false;
+		SlateRunnableTask = new FCustomSlateLoadingThreadTask( *this );
+		SlateLoadingThread = FRunnableThread::Create(SlateRunnableTask, *ThreadName, ThreadStackSize, ThreadPriority, ThreadAffinityMask);
+
+		UE_LOG(LogMoviePlayer, Log, TEXT("Created %s with priority %d, affinity mask 0x%llx, stack size %u KB"),
+			*ThreadName, (int32)ThreadPriority, ThreadAffinityMask, ThreadStackSize / 1024);
+	}
+	else
+	{
+		// The settings may have changed since the thread was created, its affinity is applied by the thread itself once armed
+		SlateLoadingThread->SetThreadPriority(ThreadPriority);
+	}
+
+	SlateLoadingThreadArmEvent->Trigger();
 }
 
-void FCustomSlateLoadingSynchronizationMechanism::DestroySlateThread()
+void FCustomSlateLoadingSynchronizationMechanism::ParkSlateThread()
 {
 	check(IsInGameThread());
 
-	if (SlateLoadingThread)
+	if (bSlateThreadArmed)
 	{
-		IsRunningSlateMainLoop.Reset();
+		const uint64 ParkStartCycles = FPlatformTime::Cycles64();
+		const double ParkStartTime = FPlatformTime::Seconds();
+		const double ParkDeadline = ParkStartTime + ShutdownTimeout;
+		bool bReportedOverrun = false;
+
+		// The slate thread only has to finish its current frame and drain the draw passes still in flight, it signals us when done
+		ResetSlateMainLoopRunning();
 
 		while (bMainLoopRunning)
 		{
-			FPlatformApplicationMisc::PumpMessages(false);
+			const double TimeLeft = ParkDeadline - FPlatformTime::Seconds();
+			if (TimeLeft > 0.0)
+			{
+				SlateLoadingThreadParkedEvent->Wait(FTimespan::FromSeconds(TimeLeft));
+			}
+			else
+			{
+				if (!bReportedOverrun)
+				{
+					UE_LOG(LogMoviePlayer, Warning, TEXT("Loading thread did not stop within %.0f ms (%d draw passes in flight), still waiting for it"),
+						ShutdownTimeout * 1000.0f, IsSlateDrawEnqueued.GetValue());
+					bReportedOverrun = true;
+				}
+
+				// Keep servicing the OS while we are stuck so the window isn't reported as hung
+				FPlatformApplicationMisc::PumpMessages(false);
+				SlateLoadingThreadParkedEvent->Wait(10);
+			}
+		}
 
-			FPlatformProcess::Sleep(0.f);
+		const double ParkTime = FPlatformTime::Seconds() - ParkStartTime;
+		if (bReportedOverrun)
+		{
+			UE_LOG(LogMoviePlayer, Warning, TEXT("Loading thread stopped %.3f ms after being asked to"), ParkTime * 1000.0);
 		}
+		else
+		{
+			UE_LOG(LogMoviePlayer, Verbose, TEXT("Loading thread stopped %.3f ms after being asked to"), ParkTime * 1000.0);
+		}
+
+		// The thread runs for as long as the game thread is loading, compare these across thread configurations
+		UE_LOG(LogMoviePlayer, Log, TEXT("Loading screen thread ran for %.3f ms with priority %d, affinity mask 0x%llx"),
+			FPlatformTime::ToMilliseconds64(ParkStartCycles - ArmCycles), (int32)ThreadPriority, ThreadAffinityMask);
+
+		bSlateThreadArmed = false;
+	}
+}
+
+void FCustomSlateLoadingSynchronizationMechanism::DestroySlateThread()
+{
+	check(IsInGameThread());
+
+	ParkSlateThread();
+
+	if (SlateLoadingThread)
+	{
+		bSlateThreadExitRequested = true;
+		SlateLoadingThreadArmEvent->Trigger();
+		SlateLoadingThread->WaitForCompletion();
 
 		delete SlateLoadingThread;
 		delete SlateRunnableTask;
@@ -87,19 +468,80 @@ void FCustomSlateLoadingSynchronizationMechanism::DestroySlateThread()
 	}
 }
 
+bool FCustomSlateLoadingSynchronizationMechanism::SlateThreadWaitUntilArmed()
+{
+	while (!bSlateThreadExitRequested)
+	{
+		// ParkSlateThread may already have stopped the main loop of this arm, the thread still has to run it to report back as parked
+		const uint32 CurrentArmGeneration = ArmGeneration;
+		if (CurrentArmGeneration != ConsumedArmGeneration)
+		{
+			ConsumedArmGeneration = CurrentArmGeneration;
+			return true;
+		}
+		SlateLoadingThreadArmEvent->Wait();
+	}
+	return false;
+}
+
+void FCustomSlateLoadingSynchronizationMechanism::SlateThreadApplyAffinity()
+{
+	FPlatformProcess::SetThreadAffinityMask(ThreadAffinityMask);
+}
+
+void FCustomSlateLoadingSynchronizationMechanism::SlateThreadParked()
+{
+	bMainLoopRunning = false;
+	SlateLoadingThreadParkedEvent->Trigger();
+}
+
 bool FCustomSlateLoadingSynchronizationMechanism::IsSlateDrawPassEnqueued()
 {
 	return IsSlateDrawEnqueued.GetValue() != 0;
 }
 
+bool FCustomSlateLoadingSynchronizationMechanism::CanEnqueueSlateDrawPass()
+{
+	return IsSlateDrawEnqueued.GetValue() < DrawPassPipelineDepth;
+}
+
 void FCustomSlateLoadingSynchronizationMechanism::SetSlateDrawPassEnqueued()
 {
-	IsSlateDrawEnqueued.Set(1);
+	// Publish the timestamp before the counter so the render thread always sees it
+	DrawPassEnqueueCycles[NumDrawPassesEnqueued++ % MaxDrawPassPipelineDepth] = FPlatformTime::Cycles64();
+
+	if (IsSlateDrawEnqueued.Increment() == 1)
+	{
+		// The ring was empty, the render thread had run dry waiting for this pass
+		++NumRenderThreadStalls;
+	}
+}
+
+void FCustomSlateLoadingSynchronizationMechanism::DequeueSlateDrawPass()
+{
+	if (IsSlateDrawPassEnqueued())
+	{
+		const uint64 EnqueueCycles = DrawPassEnqueueCycles[NumDrawPassesConsumed++ % MaxDrawPassPipelineDepth];
+		const uint64 ConsumeCycles = FPlatformTime::Cycles64();
+		{
+			FScopeLock HandoffLatencyLock(&DrawPassHandoffLatencyCriticalSection);
+			if (DrawPassHandoffLatencies.Num() < MaxNumDrawPassHandoffLatencySamples)
+			{
+				DrawPassHandoffLatencies.Add(FPlatformTime::ToMilliseconds64(ConsumeCycles - EnqueueCycles));
+			}
+		}
+
+		IsSlateDrawEnqueued.Decrement();
+		SlateLoadingThreadWakeEvent->Trigger();
+	}
 }
 
 void FCustomSlateLoadingSynchronizationMechanism::ResetSlateDrawPassEnqueued()
 {
 	IsSlateDrawEnqueued.Reset();
+	NumDrawPassesEnqueued = 0;
+	NumDrawPassesConsumed = 0;
+	SlateLoadingThreadWakeEvent->Trigger();
 }
 
 bool FCustomSlateLoadingSynchronizationMechanism::IsSlateMainLoopRunning()
@@ -115,31 +557,122 @@ void FCustomSlateLoadingSynchronizationMechanism::SetSlateMainLoopRunning()
 void FCustomSlateLoadingSynchronizationMechanism::ResetSlateMainLoopRunning()
 {
 	IsRunningSlateMainLoop.Reset();
+	FramePacer.Interrupt();
+	SlateLoadingThreadWakeEvent->Trigger();
+}
+
+void FCustomSlateLoadingSynchronizationMechanism::WaitForSlateDrawPassSlot()
+{
+	if (!CanEnqueueSlateDrawPass())
+	{
+		ASYNC_LOADING_SCREEN_TRACE_SCOPE(WaitForDrawPassSlot);
+		++NumSlateThreadStalls;
+
+		while (!CanEnqueueSlateDrawPass() && IsSlateMainLoopRunning())
+		{
+			SlateLoadingThreadWakeEvent->Wait();
+		}
+	}
+}
+
+double FCustomSlateLoadingSynchronizationMechanism::GetCurrentThreadCPUTime()
+{
+#if PLATFORM_WINDOWS
+	FILETIME CreationTime, ExitTime, KernelTime, UserTime;
+	if (::GetThreadTimes(::GetCurrentThread(), &CreationTime, &ExitTime, &KernelTime, &UserTime))
+	{
+		// In 100 ns units
+		const uint64 Kernel = ((uint64)KernelTime.dwHighDateTime << 32) | KernelTime.dwLowDateTime;
+		const uint64 User = ((uint64)UserTime.dwHighDateTime << 32) | UserTime.dwLowDateTime;
+		return (Kernel + User) * 1e-7;
+	}
+#elif PLATFORM_UNIX || PLATFORM_MAC
+	struct timespec ThreadTime;
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ThreadTime) == 0)
+	{
+		return ThreadTime.tv_sec + ThreadTime.tv_nsec * 1e-9;
+	}
+#endif
+	return -1.0;
 }
 
 void FCustomSlateLoadingSynchronizationMechanism::SlateThreadRunMainLoop()
 {
-	double LastTime = FPlatformTime::Seconds();
+	const double StartCPUTime = GetCurrentThreadCPUTime();
+	FramePacer.Reset(TargetFrameRate, CVarAsyncLoadingScreenFrameSpinThreshold.GetValueOnAnyThread() / 1000.0f);
+	NumSlateThreadStalls = 0;
+	NumRenderThreadStalls = 0;
+	NumSkippedFrames = 0;
+	bThrottled = false;
+	NumThrottledFrames = 0;
+	LastPaintTime = 0.0;
+	{
+		FScopeLock HandoffLatencyLock(&DrawPassHandoffLatencyCriticalSection);
+		DrawPassHandoffLatencies.Reset();
+	}
 
 	while (IsSlateMainLoopRunning())
 	{
-		double CurrentTime = FPlatformTime::Seconds();
-		double DeltaTime = CurrentTime - LastTime;
+		double DeltaTime = 0.0;
+		{
+			ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(SlateThreadSleep);
+			DeltaTime = FramePacer.WaitForNextFrame();
+		}
 
-		// 60 fps max
-		const double MaxTickRate = 1.0/60.0f;
+		// Paint at the background rate (or not at all) while the window is minimized or unfocused, but keep checking it often enough to resume right away
+		if (BackgroundFrameRate >= 0.0f && IsSlateMainLoopRunning())
+		{
+			const bool bInBackground = WidgetRenderer->IsMainWindowInBackground();
+			if (bInBackground != bThrottled)
+			{
+				bThrottled = bInBackground;
+				UE_LOG(LogMoviePlayer, Verbose, TEXT("Loading screen window %s, painting at %.1f fps"),
+					bThrottled ? TEXT("went to the background") : TEXT("is back in the foreground"), bThrottled ? BackgroundFrameRate : TargetFrameRate);
+			}
+
+			if (bThrottled)
+			{
+				const double CurrentTime = FPlatformTime::Seconds();
+				const double NextPaintTime = BackgroundFrameRate > 0.0f ? LastPaintTime + 1.0 / BackgroundFrameRate : MAX_dbl;
+				if (NextPaintTime > CurrentTime)
+				{
+					FramePacer.SkipUntil(FMath::Min(NextPaintTime, CurrentTime + BackgroundPollInterval));
+					++NumThrottledFrames;
+					INC_DWORD_STAT(STAT_AsyncLoadingScreen_NumSkippedFrames);
+					CSV_CUSTOM_STAT(AsyncLoadingScreen, NumSkippedFrames, 1, ECsvCustomStatOp::Accumulate);
+					continue;
+				}
+			}
+		}
 
-		const double TimeToWait = MaxTickRate - DeltaTime;
+		// Movies update every frame, otherwise only paint when something on the loading screen changed
+		if (bSkipUnchangedFrames && !MovieStreamer.IsValid() && IsSlateMainLoopRunning())
+		{
+			const double CurrentTime = FPlatformTime::Seconds();
+			const double NextRedrawTime = WidgetRenderer->GetNextRedrawTime(CurrentTime, RedrawKeepAliveInterval);
+			if (NextRedrawTime > CurrentTime)
+			{
+				// Sleep until the next animation is due, a stop request still wakes us up right away
+				FramePacer.SkipUntil(NextRedrawTime);
+				const int32 NumFramesToSkip = FMath::Max(FMath::FloorToInt(FMath::Min(NextRedrawTime - CurrentTime, (double)RedrawKeepAliveInterval) / FramePacer.GetTargetFrameTime()), 1);
+				NumSkippedFrames += NumFramesToSkip;
+				INC_DWORD_STAT_BY(STAT_AsyncLoadingScreen_NumSkippedFrames, NumFramesToSkip);
+				CSV_CUSTOM_STAT(AsyncLoadingScreen, NumSkippedFrames, NumFramesToSkip, ECsvCustomStatOp::Accumulate);
+				continue;
+			}
+		}
 
-		if( TimeToWait > 0 )
+		// The ring of draw passes is full, sleep until the render thread wakes us up instead of skipping the frame
 		{
-			FPlatformProcess::Sleep(TimeToWait);
-			CurrentTime = FPlatformTime::Seconds();
-			DeltaTime = CurrentTime - LastTime;
+			ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(SlateThreadSleep);
+			WaitForSlateDrawPassSlot();
 		}
 
-		if (FSlateApplication::IsInitialized() && !IsSlateDrawPassEnqueued())
+		if (FSlateApplication::IsInitialized() && IsSlateMainLoopRunning() && CanEnqueueSlateDrawPass())
 		{
+			ASYNC_LOADING_SCREEN_SCOPE_CYCLE_COUNTER(SlateThreadWork);
+			INC_DWORD_STAT(STAT_AsyncLoadingScreen_NumPaintedFrames);
+			CSV_CUSTOM_STAT(AsyncLoadingScreen, NumPaintedFrames, 1, ECsvCustomStatOp::Accumulate);
 			// Tick engine stuff.
 			if (MovieStreamer.IsValid())
 			{
@@ -151,8 +684,28 @@ void FCustomSlateLoadingSynchronizationMechanism::SlateThreadRunMainLoop()
 			//FScopeLock ScopeLock(MainSlateRenderer->GetResourceCriticalSection());
 
 			WidgetRenderer->DrawWindow(DeltaTime);
+			LastPaintTime = FPlatformTime::Seconds();
 
-			SetSlateDrawPassEnqueued();
+			{
+				ASYNC_LOADING_SCREEN_TRACE_SCOPE(EnqueueDrawPass);
+
+				SetSlateDrawPassEnqueued();
+
+				if (NumDrawPassesEnqueued == 1)
+				{
+					UE_LOG(LogMoviePlayer, Log, TEXT("Loading thread painted its first frame %.3f ms after being armed (%s start)"),
+						FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - ArmCycles), bWarmStart ? TEXT("warm") : TEXT("cold"));
+				}
+
+				// Hand the pass straight to the render thread instead of waiting for it to poll for it
+				FConsumeSlateDrawPassDelegate ConsumeDrawPass = ConsumeDrawPassDelegate;
+				const float DrawPassDeltaTime = DeltaTime;
+				ENQUEUE_RENDER_COMMAND(ConsumeSlateLoadingDrawPass)(
+					[ConsumeDrawPass, DrawPassDeltaTime](FRHICommandListImmediate& RHICmdList)
+					{
+						ConsumeDrawPass.ExecuteIfBound(DrawPassDeltaTime);
+					});
+			}
 
 			// Tick after rendering.
 			if (MovieStreamer.IsValid())
@@ -160,36 +713,69 @@ void FCustomSlateLoadingSynchronizationMechanism::SlateThreadRunMainLoop()
 				MovieStreamer->TickPostRender();
 			}
 		}
-
-		LastTime = CurrentTime;
 	}
 	
+	// The render thread wakes us up for every pass it consumes
+	const double DrainDeadline = FPlatformTime::Seconds() + ShutdownTimeout;
 	while (IsSlateDrawPassEnqueued())
 	{
-		FPlatformProcess::Sleep(1.f / 60.f);
+		const double TimeLeft = DrainDeadline - FPlatformTime::Seconds();
+		if (TimeLeft <= 0.0)
+		{
+			// The render thread still owns the counters of the passes in flight, the next Initialize flushes them before reusing the ring
+			UE_LOG(LogMoviePlayer, Warning, TEXT("Render thread did not consume the last %d loading screen draw passes within %.0f ms, not waiting for them"),
+				IsSlateDrawEnqueued.GetValue(), ShutdownTimeout * 1000.0f);
+			break;
+		}
+		SlateLoadingThreadWakeEvent->Wait(FTimespan::FromSeconds(TimeLeft));
 	}
-	
-	bMainLoopRunning = false;
+
+	LastRunCPUTime = StartCPUTime >= 0.0 ? GetCurrentThreadCPUTime() - StartCPUTime : -1.0;
+
+	UE_LOG(LogMoviePlayer, Verbose, TEXT("Loading thread skipped about %d unchanged frames and %d frames in the background"), NumSkippedFrames, NumThrottledFrames);
+	WidgetRenderer->LogPaintStats();
+
+	UE_LOG(LogMoviePlayer, Verbose, TEXT("Loading thread painted up to %d draw passes ahead: %d slate thread stalls, %d render thread stalls"),
+		DrawPassPipelineDepth, NumSlateThreadStalls, NumRenderThreadStalls);
+
+	FScopeLock HandoffLatencyLock(&DrawPassHandoffLatencyCriticalSection);
+	if (DrawPassHandoffLatencies.Num() > 0)
+	{
+		DrawPassHandoffLatencies.Sort();
+		auto Percentile = [this](float P) { return DrawPassHandoffLatencies[FMath::Min(FMath::FloorToInt(P * DrawPassHandoffLatencies.Num()), DrawPassHandoffLatencies.Num() - 1)]; };
+
+		UE_LOG(LogMoviePlayer, Verbose, TEXT("Loading thread draw pass handoff latency over %d passes: p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms"),
+			DrawPassHandoffLatencies.Num(), Percentile(0.5f), Percentile(0.95f), Percentile(0.99f), DrawPassHandoffLatencies.Last());
+	}
+
+	UE_LOG(LogMoviePlayer, Verbose, TEXT("Loading thread paced %d frames at %.1f fps: average %.3f ms, jitter %.3f ms, worst error %.3f ms (bound %.3f ms), %d missed deadlines"),
+		FramePacer.GetNumFrames(), 1.0 / FramePacer.GetTargetFrameTime(), FramePacer.GetAverageFrameTime() * 1000.0, FramePacer.GetFrameTimeJitter() * 1000.0,
+		FramePacer.GetMaxFrameTimeError() * 1000.0, FramePacer.GetSpinThreshold() * 1000.0, FramePacer.GetNumMissedDeadlines());
 }
 
 
 bool FCustomSlateLoadingThreadTask::Init()
 {
-	// First thing to do is set the slate loading thread ID
-	// This guarantees all systems know that a slate thread exists
-	GSlateLoadingThreadId = FPlatformTLS::GetCurrentThreadId();
-
 	return true;
 }
 
 uint32 FCustomSlateLoadingThreadTask::Run()
 {
-	check( GSlateLoadingThreadId == FPlatformTLS::GetCurrentThreadId() );
+	// The thread outlives the loading screens, it parks here between them
+	while (SyncMechanism->SlateThreadWaitUntilArmed())
+	{
+		// First thing to do is set the slate loading thread ID
+		// This guarantees all systems know that a slate thread exists
+		GSlateLoadingThreadId = FPlatformTLS::GetCurrentThreadId();
 
-	SyncMechanism->SlateThreadRunMainLoop();
+		SyncMechanism->SlateThreadApplyAffinity();
+		SyncMechanism->SlateThreadRunMainLoop();
 
-	// Tear down the slate loading thread ID
-	FPlatformAtomics::InterlockedExchange((int32*)&GSlateLoadingThreadId, 0);
+		// Tear down the slate loading thread ID while parked, so nothing mistakes it for a running slate thread
+		FPlatformAtomics::InterlockedExchange((int32*)&GSlateLoadingThreadId, 0);
+
+		SyncMechanism->SlateThreadParked();
+	}
 
 	return 0;
 }
@@ -4,9 +4,68 @@
 #include "HAL/ThreadSafeCounter.h"
 
 class FRunnable;
+class FEvent;
 class FCustomMoviePlayerWidgetRenderer;
 class IMovieStreamer;
 
+/** Called on the render thread for every draw pass the slate thread enqueues */
+DECLARE_DELEGATE_OneParam(FConsumeSlateDrawPassDelegate, float /*DeltaTime*/);
+
+/**
+ * Paces the Slate loading thread to a target frame rate.
+ * Frames are scheduled against absolute deadlines so sleep overshoot never accumulates into drift.
+ * The thread sleeps coarsely until shortly before each deadline and only spins for the remainder.
+ */
+class FCustomSlateLoadingFramePacer
+{
+public:
+	FCustomSlateLoadingFramePacer();
+	~FCustomSlateLoadingFramePacer();
+
+	/** Restarts pacing at the given rate, the first frame is due immediately */
+	void Reset(float InTargetFrameRate, float InSpinThresholdSeconds);
+
+	/** Blocks until the next frame deadline and returns the time elapsed since the previous frame */
+	double WaitForNextFrame();
+
+	/** Wakes up the current and any later WaitForNextFrame immediately, until the next Reset. Can be called from any thread */
+	void Interrupt();
+
+	/** Pushes the next frame back to the given time, the interval up to it is left out of the statistics */
+	void SkipUntil(double Time);
+
+	/** Frame interval statistics since the last Reset, in seconds */
+	int32 GetNumFrames() const { return NumFrames; }
+	int32 GetNumMissedDeadlines() const { return NumMissedDeadlines; }
+	double GetTargetFrameTime() const { return TargetFrameTime; }
+	double GetSpinThreshold() const { return SpinThreshold; }
+	double GetAverageFrameTime() const;
+	double GetFrameTimeJitter() const;
+	double GetMaxFrameTimeError() const { return MaxFrameTimeError; }
+
+private:
+	double TargetFrameTime;
+	double SpinThreshold;
+
+	/** Absolute time the next frame is due at */
+	double NextDeadline;
+	/** Absolute time the previous frame started at */
+	double LastFrameTime;
+
+	int32 NumFrames;
+	int32 NumMissedDeadlines;
+	double SumFrameTime;
+	double SumFrameTimeSquared;
+	double MaxFrameTimeError;
+
+	/** True if the next frame interval includes skipped frames */
+	bool bSkippedFrames;
+
+	/** Lets Interrupt cut the coarse sleep short */
+	FEvent* InterruptEvent;
+	TAtomic<bool> bInterrupted;
+};
+
 /**
  * This class will handle all the nasty bits about running Slate on a separate thread
  * and then trying to sync it up with the game thread and the render thread simultaneously
@@ -16,20 +75,62 @@ class FCustomSlateLoadingSynchronizationMechanism
 public:
 	FCustomSlateLoadingSynchronizationMechanism(
 		TSharedPtr<FCustomMoviePlayerWidgetRenderer, ESPMode::ThreadSafe> InWidgetRenderer,
-		const TSharedPtr<IMovieStreamer, ESPMode::ThreadSafe>& InMovieStreamer);
+		const FConsumeSlateDrawPassDelegate& InConsumeDrawPassDelegate);
 	~FCustomSlateLoadingSynchronizationMechanism();
 	
-	/** Sets up the locks in their proper initial state for running */
-	void Initialize();
+	/**
+	 * Sets up the locks in their proper initial state for running and arms the slate thread for a new loading screen.
+	 * The thread is only created the first time, afterwards the parked thread is simply woken up.
+	 */
+	void Initialize(const TSharedPtr<IMovieStreamer, ESPMode::ThreadSafe>& InMovieStreamer);
+
+	/** Stops the main loop and parks the slate thread until the next Initialize */
+	void ParkSlateThread();
 
-	/** Cleans up the slate thread */
+	/**
+	 * Parks and cleans up the slate thread.
+	 * Parking is bounded by Performance.ThreadShutdownTimeout, past it a warning is logged and the game thread keeps waiting while pumping messages.
+	 */
 	void DestroySlateThread();
 
-	/** Handles the strict alternation of the slate drawing passes */
+	/** True between Initialize and ParkSlateThread */
+	bool IsSlateThreadArmed() const { return bSlateThreadArmed; }
+
+	/**
+	 * Blocks the slate thread while it is parked, returns false once it has to exit.
+	 * Every arm is consumed exactly once, even if the main loop was already stopped again, so the thread always reports back through SlateThreadParked.
+	 */
+	bool SlateThreadWaitUntilArmed();
+	/** Called by the slate thread once armed to move itself to the configured cores */
+	void SlateThreadApplyAffinity();
+	/** Called by the slate thread once its main loop has fully stopped */
+	void SlateThreadParked();
+
+	/** Handles the bounded ring of slate drawing passes in flight between the slate thread and the render thread */
 	bool IsSlateDrawPassEnqueued();
+	bool CanEnqueueSlateDrawPass();
 	void SetSlateDrawPassEnqueued();
+	void DequeueSlateDrawPass();
 	void ResetSlateDrawPassEnqueued();
 
+	/** Number of times the slate thread had to wait because the ring was full, since the thread started */
+	int32 GetNumSlateThreadStalls() const { return NumSlateThreadStalls; }
+
+	/** Number of passes enqueued into an empty ring (the render thread had nothing left to consume), since the thread started */
+	int32 GetNumRenderThreadStalls() const { return NumRenderThreadStalls; }
+
+	/** Average frame time of the slate thread over its last run, only meaningful while it is parked */
+	double GetAverageFrameTime() const { return FramePacer.GetAverageFrameTime(); }
+
+	/** CPU time in seconds the slate thread used over its last run, only meaningful while it is parked. Negative if the platform can't tell */
+	double GetLastRunCPUTime() const { return LastRunCPUTime; }
+
+	/** CPU time in seconds the calling thread used since it started, negative if the platform can't tell */
+	static double GetCurrentThreadCPUTime();
+
+	/** Slate renderers cycle through three draw buffers, painting further ahead would stall on them */
+	static const int32 MaxDrawPassPipelineDepth = 3;
+
 	/** Handles the counter to determine if the slate thread should keep running */
 	bool IsSlateMainLoopRunning();
 	void SetSlateMainLoopRunning();
@@ -40,6 +141,9 @@ public:
 
 private:
 
+	/** Blocks the slate thread until the ring has room for another draw pass or the main loop is stopped */
+	void WaitForSlateDrawPassSlot();
+
 	/** Used as a spin lock when we're running the primary loading loop, so that we can shutdown safely. */
 	TAtomic<bool> bMainLoopRunning;
 
@@ -48,16 +152,84 @@ private:
 	 */
 	FThreadSafeCounter IsRunningSlateMainLoop;
 	/**
-	 * This counter handles strict alternation between the slate thread and the render thread
-	 * for passing Slate render draw passes between each other.
+	 * This counter holds the number of Slate render draw passes the slate thread has passed
+	 * to the render thread that have not been consumed yet, bounded by DrawPassPipelineDepth.
 	 */
 	FThreadSafeCounter IsSlateDrawEnqueued;
 
+	/** Maximum number of draw passes in flight, resolved on the game thread when the thread starts */
+	int32 DrawPassPipelineDepth;
+
+	/** Enqueue cycle counts of the draw passes in flight, indexed by pass number */
+	uint64 DrawPassEnqueueCycles[MaxDrawPassPipelineDepth];
+	/** Written by the slate thread only */
+	uint32 NumDrawPassesEnqueued;
+	/** Written by the render thread only, and reset by Initialize once no draw pass is in flight */
+	uint32 NumDrawPassesConsumed;
+
+	int32 NumSlateThreadStalls;
+	int32 NumRenderThreadStalls;
+
+	/** Signalled whenever the slate thread has something to react to: a draw pass was consumed or the main loop was stopped */
+	FEvent* SlateLoadingThreadWakeEvent;
+
+	/** Signalled to wake the parked slate thread up, either to run a new main loop or to exit */
+	FEvent* SlateLoadingThreadArmEvent;
+	/** Signalled by the slate thread once its main loop has fully stopped */
+	FEvent* SlateLoadingThreadParkedEvent;
+
+	/** Time after which parking the slate thread is reported as overrunning, resolved on the game thread when the thread is armed */
+	float ShutdownTimeout;
+
+	/** Scheduling of the slate thread, resolved on the game thread when the thread is armed */
+	EThreadPriority ThreadPriority;
+	/** Applied by the slate thread itself once armed, so it also takes effect on a reused thread */
+	uint64 ThreadAffinityMask;
+	TAtomic<bool> bSlateThreadArmed;
+	TAtomic<bool> bSlateThreadExitRequested;
+
+	/** Bumped by Initialize for every arm */
+	TAtomic<uint32> ArmGeneration;
+	/** Last arm the slate thread picked up, only used by the slate thread */
+	uint32 ConsumedArmGeneration;
+
+	/** Cycle count at which the slate thread was last armed, used to measure the time to its first frame */
+	uint64 ArmCycles;
+	/** True if the last arm reused a parked thread rather than creating one */
+	bool bWarmStart;
+
+	/** Enqueue to consume latencies of the draw passes of the current run, in milliseconds */
+	TArray<float> DrawPassHandoffLatencies;
+	FCriticalSection DrawPassHandoffLatencyCriticalSection;
+
 	/**
 	* This counter is used to generate a unique id for each new instance of the loading thread
 	*/
 	static FThreadSafeCounter LoadingThreadInstanceCounter;
 
+	/** Paces the main loop of the slate thread */
+	FCustomSlateLoadingFramePacer FramePacer;
+
+	/** Skip the frames where nothing changed, resolved on the game thread when the thread is armed */
+	bool bSkipUnchangedFrames;
+	float RedrawKeepAliveInterval;
+	int32 NumSkippedFrames;
+
+	/** Frame rate while the game window is in the background, resolved on the game thread when the thread is armed. Negative when not throttling */
+	float BackgroundFrameRate;
+	/** True while the game window is in the background */
+	bool bThrottled;
+	/** Frames not painted because the game window was in the background */
+	int32 NumThrottledFrames;
+	/** Time the last frame was painted at */
+	double LastPaintTime;
+
+	/** CPU time used by the last run of the main loop, written by the slate thread before it parks */
+	double LastRunCPUTime;
+
+	/** Target frame rate of the slate thread, resolved on the game thread when the thread starts */
+	float TargetFrameRate;
+
 	/** The worker thread that will become the Slate thread */
 	FRunnableThread* SlateLoadingThread;
 	FRunnable* SlateRunnableTask;
@@ -65,4 +237,6 @@ private:
 	TSharedPtr<FCustomMoviePlayerWidgetRenderer, ESPMode::ThreadSafe> WidgetRenderer;
 	/** Holds the current MovieStreamer. */
 	TSharedPtr<IMovieStreamer, ESPMode::ThreadSafe> MovieStreamer;
+	/** Consumes the enqueued draw passes on the render thread */
+	FConsumeSlateDrawPassDelegate ConsumeDrawPassDelegate;
 };
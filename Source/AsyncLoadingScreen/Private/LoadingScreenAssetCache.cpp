@@ -0,0 +1,249 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenAssetCache.h"
+#include "LoadingScreenSettings.h"
+#include "CustomMoviePlayer.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarAsyncLoadingScreenAssetCacheBudgetMB(
+	TEXT("AsyncLoadingScreen.AssetCacheBudgetMB"),
+	-1,
+	TEXT("Memory budget in MB of the loading screen assets kept loaded across level transitions.\n")
+	TEXT("< 0: use Performance.bCacheAssets and Performance.AssetCacheBudgetMB from the project settings (default), 0: disable the cache"),
+	ECVF_Default);
+
+static FAutoConsoleCommand AsyncLoadingScreenAssetCacheStatsCommand(
+	TEXT("AsyncLoadingScreen.AssetCacheStats"),
+	TEXT("Logs the hit and miss counters of the loading screen asset cache and the memory it holds"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FLoadingScreenAssetCache::Get().LogStats();
+	}));
+
+FLoadingScreenAssetCache& FLoadingScreenAssetCache::Get()
+{
+	static FLoadingScreenAssetCache AssetCache;
+	return AssetCache;
+}
+
+int64 FLoadingScreenAssetCache::GetBudget()
+{
+	const int32 BudgetOverride = CVarAsyncLoadingScreenAssetCacheBudgetMB.GetValueOnGameThread();
+	if (BudgetOverride >= 0)
+	{
+		return (int64)BudgetOverride * 1024 * 1024;
+	}
+
+	const FLoadingScreenPerformanceSettings& PerformanceSettings = GetDefault<ULoadingScreenSettings>()->Performance;
+	return PerformanceSettings.bCacheAssets ? (int64)FMath::Max(PerformanceSettings.AssetCacheBudgetMB, 1) * 1024 * 1024 : 0;
+}
+
+void FLoadingScreenAssetCache::Acquire(const FName& ScreenName)
+{
+	check(IsInGameThread());
+
+	CurrentScreenName = NAME_None;
+	if (ScreenName.IsNone())
+	{
+		return;
+	}
+
+	const int64 Budget = GetBudget();
+	if (Budget <= 0)
+	{
+		if (Entries.Num() > 0)
+		{
+			Empty();
+		}
+		return;
+	}
+
+	LeastRecentlyUsed.Remove(ScreenName);
+	LeastRecentlyUsed.Add(ScreenName);
+	CurrentScreenName = ScreenName;
+
+	if (Entries.Contains(ScreenName))
+	{
+		++NumHits;
+		UE_LOG(LogMoviePlayer, Verbose, TEXT("Loading screen asset cache hit for '%s' (%d hits, %d misses)"), *ScreenName.ToString(), NumHits, NumMisses);
+		return;
+	}
+
+	++NumMisses;
+	UE_LOG(LogMoviePlayer, Verbose, TEXT("Loading screen asset cache miss for '%s' (%d hits, %d misses)"), *ScreenName.ToString(), NumHits, NumMisses);
+
+	Entries.Add(ScreenName);
+}
+
+void FLoadingScreenAssetCache::Pin(const FName& ScreenName, UObject* Asset)
+{
+	check(IsInGameThread());
+
+	FEntry* Entry = Entries.Find(ScreenName);
+	if (!Entry || !Asset)
+	{
+		return;
+	}
+
+	for (const TStrongObjectPtr<UObject>& PinnedAsset : Entry->Assets)
+	{
+		if (PinnedAsset.Get() == Asset)
+		{
+			return;
+		}
+	}
+
+	const int64 AssetSize = (int64)Asset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+	Entry->Assets.Add(TStrongObjectPtr<UObject>(Asset));
+	Entry->Size += AssetSize;
+	AddReference(Asset, AssetSize);
+
+	EvictOverBudget(ScreenName);
+}
+
+void FLoadingScreenAssetCache::AddReference(UObject* Asset, int64 AssetSize)
+{
+	FAssetReference& AssetReference = AssetReferences.FindOrAdd(Asset);
+	if (AssetReference.NumReferences++ == 0)
+	{
+		AssetReference.Size = AssetSize;
+		TotalSize += AssetSize;
+	}
+}
+
+UTextureRenderTarget2D* FLoadingScreenAssetCache::FindAtlas(const TArray<FSoftObjectPath>& ImagePaths, TArray<FBox2D>& OutUVRegions) const
+{
+	check(IsInGameThread());
+
+	for (const TPair<FName, FEntry>& Entry : Entries)
+	{
+		for (const FPackedAtlas& Atlas : Entry.Value.Atlases)
+		{
+			if (Atlas.ImagePaths == ImagePaths && Atlas.Texture.IsValid())
+			{
+				OutUVRegions = Atlas.UVRegions;
+				return Atlas.Texture.Get();
+			}
+		}
+	}
+	return nullptr;
+}
+
+void FLoadingScreenAssetCache::AddAtlas(const FName& ScreenName, const TArray<FSoftObjectPath>& ImagePaths, UTextureRenderTarget2D* Atlas, const TArray<FBox2D>& UVRegions)
+{
+	check(IsInGameThread());
+
+	FEntry* Entry = Entries.Find(ScreenName);
+	if (!Entry || !Atlas)
+	{
+		return;
+	}
+
+	// The atlas may have been found for another loading screen packed from the same images
+	for (const FPackedAtlas& EntryAtlas : Entry->Atlases)
+	{
+		if (EntryAtlas.Texture.Get() == Atlas)
+		{
+			return;
+		}
+	}
+
+	FPackedAtlas& PackedAtlas = Entry->Atlases.AddDefaulted_GetRef();
+	PackedAtlas.ImagePaths = ImagePaths;
+	PackedAtlas.Texture.Reset(Atlas);
+	PackedAtlas.UVRegions = UVRegions;
+
+	const int64 AtlasSize = (int64)Atlas->CalcTextureMemorySizeEnum(TMC_ResidentMips);
+	Entry->Size += AtlasSize;
+	AddReference(Atlas, AtlasSize);
+
+	EvictOverBudget(ScreenName);
+}
+
+void FLoadingScreenAssetCache::EvictOverBudget(const FName& KeepScreenName)
+{
+	const int64 Budget = GetBudget();
+
+	// Caching a loading screen larger than the budget would hold that memory for good, its widgets keep their assets while it shows anyway
+	if (const FEntry* KeepEntry = Entries.Find(KeepScreenName))
+	{
+		if (KeepEntry->Size > Budget)
+		{
+			UE_LOG(LogMoviePlayer, Log, TEXT("Loading screen '%s' alone holds %.1f MB of assets, more than the asset cache budget of %.1f MB, not caching it"),
+				*KeepScreenName.ToString(), KeepEntry->Size / (1024.0 * 1024.0), Budget / (1024.0 * 1024.0));
+
+			RemoveEntry(KeepScreenName);
+			++NumEvictions;
+		}
+	}
+
+	for (int32 Index = 0; Index < LeastRecentlyUsed.Num() && TotalSize > Budget;)
+	{
+		const FName ScreenName = LeastRecentlyUsed[Index];
+		if (ScreenName == KeepScreenName)
+		{
+			++Index;
+			continue;
+		}
+
+		const int64 ReleasedSize = RemoveEntry(ScreenName);
+		UE_LOG(LogMoviePlayer, Verbose, TEXT("Evicted loading screen '%s' from the asset cache, releasing %.1f MB"), *ScreenName.ToString(), ReleasedSize / (1024.0 * 1024.0));
+		++NumEvictions;
+	}
+}
+
+int64 FLoadingScreenAssetCache::RemoveEntry(const FName& ScreenName)
+{
+	int64 ReleasedSize = 0;
+	if (const FEntry* Entry = Entries.Find(ScreenName))
+	{
+		// Assets still held by another cached loading screen stay counted
+		auto ReleaseReference = [this, &ReleasedSize](UObject* Asset)
+		{
+			FAssetReference* AssetReference = AssetReferences.Find(Asset);
+			if (AssetReference && --AssetReference->NumReferences == 0)
+			{
+				ReleasedSize += AssetReference->Size;
+				AssetReferences.Remove(Asset);
+			}
+		};
+
+		for (const TStrongObjectPtr<UObject>& Asset : Entry->Assets)
+		{
+			ReleaseReference(Asset.Get());
+		}
+		for (const FPackedAtlas& Atlas : Entry->Atlases)
+		{
+			ReleaseReference(Atlas.Texture.Get());
+		}
+	}
+
+	TotalSize -= ReleasedSize;
+	Entries.Remove(ScreenName);
+	LeastRecentlyUsed.Remove(ScreenName);
+
+	return ReleasedSize;
+}
+
+void FLoadingScreenAssetCache::Empty()
+{
+	Entries.Empty();
+	AssetReferences.Empty();
+	LeastRecentlyUsed.Empty();
+	CurrentScreenName = NAME_None;
+	TotalSize = 0;
+}
+
+void FLoadingScreenAssetCache::LogStats() const
+{
+	const int32 NumLookups = NumHits + NumMisses;
+	UE_LOG(LogMoviePlayer, Log, TEXT("Loading screen asset cache: %d hits, %d misses (%.0f%% hit rate), %d evictions, %d loading screens holding %.1f of %.1f MB"),
+		NumHits, NumMisses, NumLookups > 0 ? 100.0 * NumHits / NumLookups : 0.0, NumEvictions, Entries.Num(), TotalSize / (1024.0 * 1024.0), GetBudget() / (1024.0 * 1024.0));
+}
@@ -0,0 +1,110 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/StrongObjectPtr.h"
+
+class UTextureRenderTarget2D;
+
+/**
+ * Keeps the assets of the recently shown loading screens loaded across level transitions, within Performance.AssetCacheBudgetMB.
+ * Loading screens are keyed by settings name (see UAsyncLoadingScreenLibrary::GetLoadingScreenSettingsByName) and evicted least recently used first.
+ * Only the assets the widgets of a loading screen resolved are kept, a loading screen holding more than the budget on its own isn't cached.
+ * An asset shared by several loading screens counts once against the budget.
+ * Only used on the game thread.
+ */
+class FLoadingScreenAssetCache
+{
+public:
+	static FLoadingScreenAssetCache& Get();
+
+	/**
+	 * Called when a loading screen is set up, before its widgets are created. NAME_None for a loading screen that isn't cached.
+	 * On a miss, the loading screen starts empty and keeps what its widgets pin.
+	 */
+	void Acquire(const FName& ScreenName);
+
+	/** Loading screen being set up, widgets pass it back to Pin and AddAtlas once their assets are loaded. NAME_None if it isn't cached */
+	FName GetCurrentScreenName() const { return CurrentScreenName; }
+
+	/** Keeps an asset a widget of the given loading screen resolved, nothing happens if that loading screen isn't cached (anymore) */
+	void Pin(const FName& ScreenName, UObject* Asset);
+
+	/** Finds an atlas packed from the given images for a cached loading screen, see SLoadingFlipbook::PackAtlas */
+	UTextureRenderTarget2D* FindAtlas(const TArray<FSoftObjectPath>& ImagePaths, TArray<FBox2D>& OutUVRegions) const;
+
+	/** Keeps an atlas packed from the given images along with the assets of the given loading screen, if it is cached */
+	void AddAtlas(const FName& ScreenName, const TArray<FSoftObjectPath>& ImagePaths, UTextureRenderTarget2D* Atlas, const TArray<FBox2D>& UVRegions);
+
+	/** Releases every cached loading screen */
+	void Empty();
+
+	/** Logs the hit and miss counters and the memory held */
+	void LogStats() const;
+
+	int32 GetNumHits() const { return NumHits; }
+	int32 GetNumMisses() const { return NumMisses; }
+	int64 GetResidentSize() const { return TotalSize; }
+
+private:
+	/** Image sequence packed into a render target */
+	struct FPackedAtlas
+	{
+		TArray<FSoftObjectPath> ImagePaths;
+		TStrongObjectPtr<UTextureRenderTarget2D> Texture;
+		TArray<FBox2D> UVRegions;
+	};
+
+	struct FEntry
+	{
+		TArray<TStrongObjectPtr<UObject>> Assets;
+		TArray<FPackedAtlas> Atlases;
+
+		// Size of the assets and atlases of this loading screen, shared ones included
+		int64 Size = 0;
+	};
+
+	/** Cached loading screens holding an asset */
+	struct FAssetReference
+	{
+		int32 NumReferences = 0;
+		int64 Size = 0;
+	};
+
+	/** Memory budget in bytes, 0 when the cache is disabled */
+	static int64 GetBudget();
+
+	/** Evicts the least recently used loading screens until the budget is met, and KeepScreenName last if it alone is over budget */
+	void EvictOverBudget(const FName& KeepScreenName);
+
+	/** Releases a cached loading screen, returns the memory it alone held */
+	int64 RemoveEntry(const FName& ScreenName);
+
+	/** Counts an asset held by a cached loading screen, TotalSize only grows the first time */
+	void AddReference(UObject* Asset, int64 AssetSize);
+
+	TMap<FName, FEntry> Entries;
+
+	// Assets held by the cached loading screens, they are held strongly by the entries as long as they are referenced here
+	TMap<UObject*, FAssetReference> AssetReferences;
+
+	// Cached loading screens, least recently used first
+	TArray<FName> LeastRecentlyUsed;
+
+	// Loading screen last set up, NAME_None if it isn't cached
+	FName CurrentScreenName;
+
+	// Memory held by the cached loading screens, each asset counted once
+	int64 TotalSize = 0;
+
+	int32 NumHits = 0;
+	int32 NumMisses = 0;
+	int32 NumEvictions = 0;
+};
@@ -0,0 +1,340 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenBenchmark.h"
+#include "AsyncLoadingScreenLibrary.h"
+#include "CustomMoviePlayer.h"
+#include "CustomMoviePlayerThreading.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectGlobals.h"
+
+static FAutoConsoleCommand AsyncLoadingScreenBenchmarkCommand(
+	TEXT("AsyncLoadingScreen.Benchmark"),
+	TEXT("Loads a map repeatedly without a loading screen, with each layout and with each loading icon type, and writes the load times and CPU times as JSON.\n")
+	TEXT("Usage: AsyncLoadingScreen.Benchmark <MapName> [Iterations=3] [Output=<Path>], Saved/AsyncLoadingScreen/Benchmark.json by default"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FString MapName;
+		int32 NumIterations = 3;
+		FString OutputPath = FLoadingScreenBenchmark::GetDefaultOutputPath();
+		for (const FString& Arg : Args)
+		{
+			if (!FParse::Value(*Arg, TEXT("Iterations="), NumIterations) && !FParse::Value(*Arg, TEXT("Output="), OutputPath))
+			{
+				MapName = Arg;
+			}
+		}
+
+		if (MapName.IsEmpty())
+		{
+			UE_LOG(LogMoviePlayer, Error, TEXT("AsyncLoadingScreen.Benchmark needs the map to load"));
+			return;
+		}
+
+		FLoadingScreenBenchmark::Start(MapName, FMath::Max(NumIterations, 1), OutputPath);
+	}));
+
+namespace
+{
+	/** Settings name the benchmark loading screens are added under to ULoadingScreenSettings::CustomLoadingScreens */
+	const FName BenchmarkScreenName(TEXT("__benchmark"));
+
+	/** A load taking longer than this is considered stuck and aborts the benchmark */
+	const double MaxLoadTime = 300.0;
+
+	/** Mean, median, min and max of the given values in milliseconds, negative values (unknown) are left out */
+	TSharedRef<FJsonObject> MakeSummary(TArray<double> Values)
+	{
+		Values.RemoveAll([](double Value) { return Value < 0.0; });
+		Values.Sort();
+
+		TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+		if (Values.Num() > 0)
+		{
+			double Sum = 0.0;
+			for (double Value : Values)
+			{
+				Sum += Value;
+			}
+
+			Summary->SetNumberField(TEXT("mean"), Sum / Values.Num() * 1000.0);
+			Summary->SetNumberField(TEXT("median"), Values[Values.Num() / 2] * 1000.0);
+			Summary->SetNumberField(TEXT("min"), Values[0] * 1000.0);
+			Summary->SetNumberField(TEXT("max"), Values.Last() * 1000.0);
+		}
+		return Summary;
+	}
+}
+
+TSharedPtr<FLoadingScreenBenchmark> FLoadingScreenBenchmark::RunningBenchmark;
+
+FString FLoadingScreenBenchmark::GetDefaultOutputPath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("AsyncLoadingScreen") / TEXT("Benchmark.json");
+}
+
+void FLoadingScreenBenchmark::Start(const FString& MapName, int32 NumIterations, const FString& OutputPath)
+{
+	check(IsInGameThread());
+
+	if (RunningBenchmark.IsValid())
+	{
+		UE_LOG(LogMoviePlayer, Warning, TEXT("A loading screen benchmark is already running"));
+		return;
+	}
+
+	TSharedRef<FLoadingScreenBenchmark> Benchmark = MakeShareable(new FLoadingScreenBenchmark(MapName, OutputPath));
+	Benchmark->AddConfigurations(NumIterations);
+	Benchmark->Samples.SetNum(Benchmark->Configurations.Num());
+
+	// Only the loading screens of the benchmark are shown, the regular one would show up on top of the baseline
+	ULoadingScreenSettings* Settings = GetMutableDefault<ULoadingScreenSettings>();
+	Benchmark->SavedDefaultLoadingScreen = Settings->DefaultLoadingScreen;
+	Settings->DefaultLoadingScreen.bShowWidgetOverlay = false;
+	Settings->DefaultLoadingScreen.MoviePaths.Empty();
+
+	Benchmark->PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddSP(Benchmark, &FLoadingScreenBenchmark::OnPostLoadMap);
+	Benchmark->TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(Benchmark, &FLoadingScreenBenchmark::Tick));
+
+	UE_LOG(LogMoviePlayer, Display, TEXT("Loading screen benchmark started: %d configurations loading %s %d times each"), Benchmark->Configurations.Num() - 1, *MapName, NumIterations);
+	RunningBenchmark = Benchmark;
+}
+
+void FLoadingScreenBenchmark::Abort()
+{
+	if (RunningBenchmark.IsValid())
+	{
+		UE_LOG(LogMoviePlayer, Warning, TEXT("Loading screen benchmark aborted"));
+
+		FTicker::GetCoreTicker().RemoveTicker(RunningBenchmark->TickerHandle);
+		RunningBenchmark->Finish();
+	}
+}
+
+FLoadingScreenBenchmark::FLoadingScreenBenchmark(const FString& InMapName, const FString& InOutputPath)
+	: MapName(InMapName)
+	, OutputPath(InOutputPath)
+{
+}
+
+FLoadingScreenBenchmark::~FLoadingScreenBenchmark()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+}
+
+void FLoadingScreenBenchmark::AddConfigurations(int32 NumIterations)
+{
+	FALoadingScreenSettings BaseSettings = GetDefault<ULoadingScreenSettings>()->DefaultLoadingScreen;
+	BaseSettings.bShowWidgetOverlay = true;
+	BaseSettings.MoviePaths.Empty();
+	BaseSettings.MinimumLoadingScreenDisplayTime = -1.0f;
+	BaseSettings.bAutoCompleteWhenLoadingCompletes = true;
+	BaseSettings.bWaitForManualStop = false;
+
+	// The first load pulls the map into the file cache, it would skew whatever is measured first
+	FConfiguration& WarmUp = Configurations.AddDefaulted_GetRef();
+	WarmUp.Name = TEXT("WarmUp");
+	WarmUp.bShowLoadingScreen = false;
+	WarmUp.bRecord = false;
+
+	FConfiguration& Baseline = Configurations.AddDefaulted_GetRef();
+	Baseline.Name = TEXT("None");
+	Baseline.bShowLoadingScreen = false;
+	Baseline.NumIterations = NumIterations;
+
+	const UEnum* LayoutEnum = StaticEnum<EAsyncLoadingScreenLayout>();
+	for (int32 Index = 0; Index < LayoutEnum->NumEnums() - 1; ++Index)
+	{
+		FConfiguration& Configuration = Configurations.AddDefaulted_GetRef();
+		Configuration.Name = FString::Printf(TEXT("Layout.%s"), *LayoutEnum->GetNameStringByIndex(Index));
+		Configuration.Settings = BaseSettings;
+		Configuration.Settings.Layout = (EAsyncLoadingScreenLayout)LayoutEnum->GetValueByIndex(Index);
+		Configuration.NumIterations = NumIterations;
+	}
+
+	const UEnum* LoadingIconEnum = StaticEnum<ELoadingIconType>();
+	for (int32 Index = 0; Index < LoadingIconEnum->NumEnums() - 1; ++Index)
+	{
+		FConfiguration& Configuration = Configurations.AddDefaulted_GetRef();
+		Configuration.Name = FString::Printf(TEXT("LoadingIcon.%s"), *LoadingIconEnum->GetNameStringByIndex(Index));
+		Configuration.Settings = BaseSettings;
+		Configuration.Settings.LoadingWidget.LoadingIconType = (ELoadingIconType)LoadingIconEnum->GetValueByIndex(Index);
+		Configuration.NumIterations = NumIterations;
+	}
+}
+
+bool FLoadingScreenBenchmark::Tick(float DeltaTime)
+{
+	// Finishing releases the last reference to the benchmark
+	TSharedRef<FLoadingScreenBenchmark> KeepAlive = AsShared();
+
+	switch (State)
+	{
+	case EState::StartLoad:
+		StartLoad();
+		break;
+
+	case EState::Loading:
+		if (FPlatformTime::Seconds() - LoadStartTime > MaxLoadTime)
+		{
+			UE_LOG(LogMoviePlayer, Error, TEXT("Loading %s did not finish within %.0f s, aborting the loading screen benchmark"), *MapName, MaxLoadTime);
+			Finish();
+			return false;
+		}
+		break;
+
+	case EState::Loaded:
+		FinishLoad();
+		if (ConfigurationIndex >= Configurations.Num())
+		{
+			WriteResults();
+			Finish();
+			return false;
+		}
+		break;
+	}
+
+	return RunningBenchmark.IsValid();
+}
+
+void FLoadingScreenBenchmark::StartLoad()
+{
+	UWorld* World = GEngine && GEngine->GameViewport ? GEngine->GameViewport->GetWorld() : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogMoviePlayer, Error, TEXT("The loading screen benchmark needs a game viewport to travel from"));
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		Finish();
+		return;
+	}
+
+	const FConfiguration& Configuration = Configurations[ConfigurationIndex];
+
+	CurrentSample = FSample();
+	LoadStartTime = FPlatformTime::Seconds();
+	LoadStartCPUTime = FCustomSlateLoadingSynchronizationMechanism::GetCurrentThreadCPUTime();
+
+	// Starting the loading screen is part of its cost
+	if (Configuration.bShowLoadingScreen)
+	{
+		GetMutableDefault<ULoadingScreenSettings>()->CustomLoadingScreens.Add(BenchmarkScreenName, Configuration.Settings);
+		UAsyncLoadingScreenLibrary::StartCustomLoadingScreen(BenchmarkScreenName);
+	}
+
+	GEngine->SetClientTravel(World, *MapName, TRAVEL_Absolute);
+	State = EState::Loading;
+}
+
+void FLoadingScreenBenchmark::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	if (State != EState::Loading)
+	{
+		return;
+	}
+
+	CurrentSample.LoadTime = FPlatformTime::Seconds() - LoadStartTime;
+	const double LoadEndCPUTime = FCustomSlateLoadingSynchronizationMechanism::GetCurrentThreadCPUTime();
+	CurrentSample.GameThreadCPUTime = LoadStartCPUTime >= 0.0 && LoadEndCPUTime >= 0.0 ? LoadEndCPUTime - LoadStartCPUTime : -1.0;
+
+	// The loading screen is stopped on the next tick, outside of the map load
+	State = EState::Loaded;
+}
+
+void FLoadingScreenBenchmark::FinishLoad()
+{
+	const FConfiguration& Configuration = Configurations[ConfigurationIndex];
+
+	if (Configuration.bShowLoadingScreen && FCustomMoviePlayer::Get())
+	{
+		FCustomMoviePlayer::Get()->StopMovie();
+		CurrentSample.LoadingThreadCPUTime = FCustomMoviePlayer::Get()->GetLoadingThreadCPUTime();
+	}
+
+	UE_LOG(LogMoviePlayer, Display, TEXT("Loading screen benchmark %s %d/%d: loaded in %.1f ms, game thread %.1f ms CPU, loading thread %.1f ms CPU"),
+		*Configuration.Name, IterationIndex + 1, Configuration.NumIterations, CurrentSample.LoadTime * 1000.0,
+		CurrentSample.GameThreadCPUTime * 1000.0, CurrentSample.LoadingThreadCPUTime * 1000.0);
+
+	Samples[ConfigurationIndex].Add(CurrentSample);
+
+	if (++IterationIndex >= Configuration.NumIterations)
+	{
+		IterationIndex = 0;
+		++ConfigurationIndex;
+	}
+
+	State = EState::StartLoad;
+}
+
+void FLoadingScreenBenchmark::Finish()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+	ULoadingScreenSettings* Settings = GetMutableDefault<ULoadingScreenSettings>();
+	Settings->DefaultLoadingScreen = SavedDefaultLoadingScreen;
+	Settings->CustomLoadingScreens.Remove(BenchmarkScreenName);
+
+	RunningBenchmark.Reset();
+}
+
+void FLoadingScreenBenchmark::WriteResults() const
+{
+	TSharedRef<FJsonObject> Results = MakeShared<FJsonObject>();
+	Results->SetStringField(TEXT("map"), MapName);
+	Results->SetStringField(TEXT("build"), FApp::GetBuildVersion());
+	Results->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+
+	TArray<TSharedPtr<FJsonValue>> ConfigurationResults;
+	for (int32 Index = 0; Index < Configurations.Num(); ++Index)
+	{
+		if (!Configurations[Index].bRecord)
+		{
+			continue;
+		}
+
+		TArray<double> LoadTimes;
+		TArray<double> GameThreadCPUTimes;
+		TArray<double> LoadingThreadCPUTimes;
+		for (const FSample& Sample : Samples[Index])
+		{
+			LoadTimes.Add(Sample.LoadTime);
+			GameThreadCPUTimes.Add(Sample.GameThreadCPUTime);
+			LoadingThreadCPUTimes.Add(Sample.LoadingThreadCPUTime);
+		}
+
+		TSharedRef<FJsonObject> ConfigurationResult = MakeShared<FJsonObject>();
+		ConfigurationResult->SetStringField(TEXT("name"), Configurations[Index].Name);
+		ConfigurationResult->SetNumberField(TEXT("loads"), Samples[Index].Num());
+		ConfigurationResult->SetObjectField(TEXT("loadTimeMs"), MakeSummary(LoadTimes));
+		ConfigurationResult->SetObjectField(TEXT("gameThreadCpuMs"), MakeSummary(GameThreadCPUTimes));
+		ConfigurationResult->SetObjectField(TEXT("loadingThreadCpuMs"), MakeSummary(LoadingThreadCPUTimes));
+		ConfigurationResults.Add(MakeShared<FJsonValueObject>(ConfigurationResult));
+	}
+	Results->SetArrayField(TEXT("configurations"), ConfigurationResults);
+
+	FString Json;
+	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Results, JsonWriter);
+
+	if (FFileHelper::SaveStringToFile(Json, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogMoviePlayer, Display, TEXT("Loading screen benchmark results written to %s"), *OutputPath);
+	}
+	else
+	{
+		UE_LOG(LogMoviePlayer, Error, TEXT("Failed to write the loading screen benchmark results to %s"), *OutputPath);
+	}
+}
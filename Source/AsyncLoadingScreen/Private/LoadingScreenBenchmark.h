@@ -0,0 +1,98 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "LoadingScreenSettings.h"
+
+class UWorld;
+
+/**
+ * Measures how much the custom loading screen slows down loading a map, driven by the "AsyncLoadingScreen.Benchmark" console command.
+ * The map is loaded repeatedly without a loading screen, with each layout and with each loading icon type,
+ * and the wall clock load time, game thread CPU time and loading thread CPU time of every load are written as JSON.
+ * Only used on the game thread.
+ */
+class FLoadingScreenBenchmark : public TSharedFromThis<FLoadingScreenBenchmark>
+{
+public:
+	/** Starts the benchmark unless one is already running, the results are written to OutputPath once done */
+	static void Start(const FString& MapName, int32 NumIterations, const FString& OutputPath);
+
+	/** Aborts the running benchmark, called on module shutdown */
+	static void Abort();
+
+	static FString GetDefaultOutputPath();
+
+	~FLoadingScreenBenchmark();
+
+private:
+	/** Loading screen a map is loaded with */
+	struct FConfiguration
+	{
+		FString Name;
+		FALoadingScreenSettings Settings;
+		bool bShowLoadingScreen = true;
+		// The warm up load is left out of the results
+		bool bRecord = true;
+		int32 NumIterations = 1;
+	};
+
+	/** Timings of one load, in seconds. CPU times are negative when the platform can't tell */
+	struct FSample
+	{
+		double LoadTime = 0.0;
+		double GameThreadCPUTime = -1.0;
+		double LoadingThreadCPUTime = -1.0;
+	};
+
+	enum class EState : uint8
+	{
+		StartLoad,
+		Loading,
+		Loaded,
+	};
+
+	FLoadingScreenBenchmark(const FString& InMapName, const FString& InOutputPath);
+
+	/** Fills the configurations from the DefaultLoadingScreen, with NumIterations loads each */
+	void AddConfigurations(int32 NumIterations);
+
+	bool Tick(float DeltaTime);
+	void StartLoad();
+	void OnPostLoadMap(UWorld* LoadedWorld);
+	void FinishLoad();
+
+	/** Restores the settings changed for the benchmark */
+	void Finish();
+
+	void WriteResults() const;
+
+	FString MapName;
+	FString OutputPath;
+
+	TArray<FConfiguration> Configurations;
+	TArray<TArray<FSample>> Samples;
+	int32 ConfigurationIndex = 0;
+	int32 IterationIndex = 0;
+
+	EState State = EState::StartLoad;
+	FSample CurrentSample;
+	double LoadStartTime = 0.0;
+	double LoadStartCPUTime = -1.0;
+
+	/** Restored once done, the benchmark doesn't want the regular loading screen on top of its own */
+	FALoadingScreenSettings SavedDefaultLoadingScreen;
+
+	FDelegateHandle TickerHandle;
+	FDelegateHandle PostLoadMapHandle;
+
+	static TSharedPtr<FLoadingScreenBenchmark> RunningBenchmark;
+};
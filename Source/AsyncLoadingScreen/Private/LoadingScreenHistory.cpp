@@ -0,0 +1,250 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenHistory.h"
+#include "LoadingScreenSettings.h"
+#include "CustomMoviePlayer.h"
+#include "MoviePlayer.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+static TAutoConsoleVariable<int32> CVarAsyncLoadingScreenRecordLoadHistory(
+	TEXT("AsyncLoadingScreen.RecordLoadHistory"),
+	-1,
+	TEXT("Append the timings of every loading screen to Saved/AsyncLoadingScreen/LoadHistory.csv.\n")
+	TEXT("< 0: use Performance.bRecordLoadHistory from the project settings (default), 0: disable, 1: enable"),
+	ECVF_Default);
+
+static FAutoConsoleCommand AsyncLoadingScreenLoadHistoryCommand(
+	TEXT("AsyncLoadingScreen.LoadHistory"),
+	TEXT("Logs the p50, p95 and p99 of the loading screen timings recorded in Saved/AsyncLoadingScreen/LoadHistory.csv per map.\n")
+	TEXT("The loading screens played by the engine movie player have no first frame and loading thread frame times.\n")
+	TEXT("Usage: AsyncLoadingScreen.LoadHistory [MapName] [Build=<BuildVersion>]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FString MapFilter;
+		FString BuildFilter;
+		for (const FString& Arg : Args)
+		{
+			if (!FParse::Value(*Arg, TEXT("Build="), BuildFilter))
+			{
+				MapFilter = Arg;
+			}
+		}
+
+		FLoadingScreenHistory::Get().LogPercentiles(MapFilter, BuildFilter);
+	}));
+
+namespace
+{
+	/** Columns of the history file, the timings are in milliseconds */
+	const TCHAR* LoadHistoryHeader = TEXT("Time,Build,Screen,Map,TimeToFirstFrameMs,LoadTimeMs,ExtraWaitMs,AverageFrameMs");
+	const int32 NumLoadHistoryColumns = 8;
+
+	/** Nearest rank percentile of sorted values */
+	double GetPercentile(const TArray<double>& SortedValues, double Percentile)
+	{
+		if (SortedValues.Num() == 0)
+		{
+			return 0.0;
+		}
+
+		const int32 Rank = FMath::CeilToInt(Percentile / 100.0 * SortedValues.Num());
+		return SortedValues[FMath::Clamp(Rank - 1, 0, SortedValues.Num() - 1)];
+	}
+
+	FString FormatPercentiles(TArray<double>& Values)
+	{
+		Values.Sort();
+		return FString::Printf(TEXT("%.1f / %.1f / %.1f"), GetPercentile(Values, 50.0), GetPercentile(Values, 95.0), GetPercentile(Values, 99.0));
+	}
+}
+
+FLoadingScreenHistory& FLoadingScreenHistory::Get()
+{
+	static FLoadingScreenHistory History;
+	return History;
+}
+
+FString FLoadingScreenHistory::GetHistoryFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("AsyncLoadingScreen") / TEXT("LoadHistory.csv");
+}
+
+void FLoadingScreenHistory::Register()
+{
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddRaw(this, &FLoadingScreenHistory::OnPreLoadMap);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FLoadingScreenHistory::OnPostLoadMap);
+
+	if (IsMoviePlayerEnabled())
+	{
+		MoviePlaybackFinishedHandle = GetMoviePlayer()->OnMoviePlaybackFinished().AddRaw(this, &FLoadingScreenHistory::OnEngineMoviePlaybackFinished);
+	}
+}
+
+void FLoadingScreenHistory::Unregister()
+{
+	FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+	if (MoviePlaybackFinishedHandle.IsValid() && GetMoviePlayer())
+	{
+		GetMoviePlayer()->OnMoviePlaybackFinished().Remove(MoviePlaybackFinishedHandle);
+	}
+}
+
+void FLoadingScreenHistory::BeginLoadingScreen()
+{
+	LoadingMapName.Reset();
+}
+
+void FLoadingScreenHistory::BeginEngineLoadingScreen(const FName& ScreenName)
+{
+	// The engine movie player prepares its loading screen from PreLoadMap, the map name it covers is already known
+	EngineScreenName = ScreenName;
+	EngineSetupTime = FPlatformTime::Seconds();
+	EngineLoadFinishedTime = 0.0;
+}
+
+void FLoadingScreenHistory::OnPreLoadMap(const FString& MapName)
+{
+	LoadingMapName = FPackageName::GetShortName(MapName);
+}
+
+void FLoadingScreenHistory::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	// The map actually loaded, a failed travel falls back to another one
+	if (LoadedWorld)
+	{
+		LoadingMapName = LoadedWorld->GetMapName();
+	}
+
+	if (!EngineScreenName.IsNone() && EngineLoadFinishedTime == 0.0)
+	{
+		EngineLoadFinishedTime = FPlatformTime::Seconds();
+	}
+}
+
+void FLoadingScreenHistory::OnEngineMoviePlaybackFinished()
+{
+	if (EngineScreenName.IsNone())
+	{
+		return;
+	}
+
+	// The engine movie player may finish from its own PostLoadMapWithWorld callback before ours, without any extra wait to tell apart
+	const double CurrentTime = FPlatformTime::Seconds();
+	const double LoadFinishedTime = EngineLoadFinishedTime > 0.0 ? EngineLoadFinishedTime : CurrentTime;
+
+	FRecord Record;
+	Record.ScreenName = EngineScreenName.ToString();
+	Record.LoadTime = LoadFinishedTime - EngineSetupTime;
+	Record.ExtraWaitTime = CurrentTime - LoadFinishedTime;
+	EngineScreenName = NAME_None;
+
+	Append(MoveTemp(Record));
+}
+
+void FLoadingScreenHistory::Append(FRecord&& Record)
+{
+	check(IsInGameThread());
+
+	const int32 RecordOverride = CVarAsyncLoadingScreenRecordLoadHistory.GetValueOnGameThread();
+	if (!(RecordOverride >= 0 ? RecordOverride != 0 : GetDefault<ULoadingScreenSettings>()->Performance.bRecordLoadHistory))
+	{
+		return;
+	}
+
+	Record.MapName = LoadingMapName.IsEmpty() ? TEXT("None") : LoadingMapName;
+
+	// Keep the file a plain one line per record CSV
+	auto Sanitize = [](FString Value) { return Value.Replace(TEXT(","), TEXT("_")).Replace(TEXT("\n"), TEXT(" ")); };
+
+	const FString HistoryFilePath = GetHistoryFilePath();
+	FString Line;
+	if (!IFileManager::Get().FileExists(*HistoryFilePath))
+	{
+		Line = FString(LoadHistoryHeader) + LINE_TERMINATOR;
+	}
+
+	Line += FString::Printf(TEXT("%s,%s,%s,%s,%.1f,%.1f,%.1f,%.2f") LINE_TERMINATOR,
+		*FDateTime::UtcNow().ToIso8601(), *Sanitize(FApp::GetBuildVersion()), *Sanitize(Record.ScreenName), *Sanitize(Record.MapName),
+		Record.TimeToFirstFrame * 1000.0, Record.LoadTime * 1000.0, Record.ExtraWaitTime * 1000.0, Record.AverageFrameTime * 1000.0);
+
+	if (!FFileHelper::SaveStringToFile(Line, *HistoryFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogMoviePlayer, Warning, TEXT("Failed to append to the loading screen history %s"), *HistoryFilePath);
+	}
+}
+
+void FLoadingScreenHistory::LogPercentiles(const FString& MapFilter, const FString& BuildFilter) const
+{
+	const FString HistoryFilePath = GetHistoryFilePath();
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *HistoryFilePath))
+	{
+		UE_LOG(LogMoviePlayer, Display, TEXT("No loading screen history at %s, enable Performance.bRecordLoadHistory or AsyncLoadingScreen.RecordLoadHistory to record one"), *HistoryFilePath);
+		return;
+	}
+
+	struct FMapTimings
+	{
+		TArray<double> TimeToFirstFrame;
+		TArray<double> LoadTime;
+		TArray<double> ExtraWaitTime;
+		TArray<double> AverageFrameTime;
+	};
+	TMap<FString, FMapTimings> TimingsByMap;
+
+	for (const FString& Line : Lines)
+	{
+		TArray<FString> Columns;
+		if (Line.ParseIntoArray(Columns, TEXT(","), false) != NumLoadHistoryColumns || Line.StartsWith(TEXT("Time,")))
+		{
+			continue;
+		}
+
+		const FString& MapName = Columns[3];
+		if ((!MapFilter.IsEmpty() && MapName != MapFilter) || (!BuildFilter.IsEmpty() && Columns[1] != BuildFilter))
+		{
+			continue;
+		}
+
+		FMapTimings& Timings = TimingsByMap.FindOrAdd(MapName);
+		const double TimeToFirstFrame = FCString::Atod(*Columns[4]);
+		if (TimeToFirstFrame >= 0.0)
+		{
+			Timings.TimeToFirstFrame.Add(TimeToFirstFrame);
+		}
+		Timings.LoadTime.Add(FCString::Atod(*Columns[5]));
+		Timings.ExtraWaitTime.Add(FCString::Atod(*Columns[6]));
+		const double AverageFrameTime = FCString::Atod(*Columns[7]);
+		if (AverageFrameTime >= 0.0)
+		{
+			Timings.AverageFrameTime.Add(AverageFrameTime);
+		}
+	}
+
+	UE_LOG(LogMoviePlayer, Display, TEXT("Loading screen history %s%s, p50 / p95 / p99 in ms:"), *HistoryFilePath, BuildFilter.IsEmpty() ? TEXT("") : *FString::Printf(TEXT(" for build %s"), *BuildFilter));
+
+	TimingsByMap.KeySort(TLess<FString>());
+	for (TPair<FString, FMapTimings>& MapTimings : TimingsByMap)
+	{
+		FMapTimings& Timings = MapTimings.Value;
+		UE_LOG(LogMoviePlayer, Display, TEXT("  %s (%d loads): first frame %s, load %s, extra wait %s, loading thread frame %s"),
+			*MapTimings.Key, Timings.LoadTime.Num(), *FormatPercentiles(Timings.TimeToFirstFrame), *FormatPercentiles(Timings.LoadTime),
+			*FormatPercentiles(Timings.ExtraWaitTime), *FormatPercentiles(Timings.AverageFrameTime));
+	}
+}
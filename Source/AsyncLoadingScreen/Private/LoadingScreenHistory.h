@@ -0,0 +1,75 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+/**
+ * Appends the timings of every loading screen shown to Saved/AsyncLoadingScreen/LoadHistory.csv when Performance.bRecordLoadHistory is set,
+ * and reports their percentiles per map with the "AsyncLoadingScreen.LoadHistory" console command. Only used on the game thread.
+ * Custom loading screens record all their timings, the loading screens played by the engine movie player (startup and default ones) only their load and extra wait times.
+ */
+class FLoadingScreenHistory
+{
+public:
+	/** Timings of a loading screen, in seconds */
+	struct FRecord
+	{
+		FString ScreenName;
+		FString MapName;
+		// From the setup of the loading screen to its first frame on screen, negative if it never presented one
+		double TimeToFirstFrame = -1.0;
+		// From the setup of the loading screen until loading finished
+		double LoadTime = 0.0;
+		// Time the loading screen stayed up after loading finished, for MinimumLoadingScreenDisplayTime or a manual stop
+		double ExtraWaitTime = 0.0;
+		// Average frame time of the loading thread, negative if it isn't measured
+		double AverageFrameTime = -1.0;
+	};
+
+	static FLoadingScreenHistory& Get();
+
+	/** Starts and stops following the maps being loaded, called on module startup and shutdown */
+	void Register();
+	void Unregister();
+
+	/** Called when a custom loading screen starts playing, the maps loaded from now on are attributed to it */
+	void BeginLoadingScreen();
+
+	/** Called when a loading screen is set up on the engine movie player, it is recorded once the engine movie player finishes playing it */
+	void BeginEngineLoadingScreen(const FName& ScreenName);
+
+	/** Appends the record of the loading screen that just finished, along with the map it covered, unless disabled */
+	void Append(FRecord&& Record);
+
+	/** Logs the p50, p95 and p99 of the recorded timings per map, optionally only for one map and one build version */
+	void LogPercentiles(const FString& MapFilter, const FString& BuildFilter) const;
+
+	static FString GetHistoryFilePath();
+
+private:
+	void OnPreLoadMap(const FString& MapName);
+	void OnPostLoadMap(UWorld* LoadedWorld);
+	void OnEngineMoviePlaybackFinished();
+
+	/** Short name of the map loaded since the loading screen started, empty if none */
+	FString LoadingMapName;
+
+	// Loading screen set up on the engine movie player, NAME_None once recorded
+	FName EngineScreenName;
+	double EngineSetupTime = 0.0;
+	// Time the map covered by the engine loading screen finished loading at, 0 until then
+	double EngineLoadFinishedTime = 0.0;
+
+	FDelegateHandle PreLoadMapHandle;
+	FDelegateHandle PostLoadMapHandle;
+	FDelegateHandle MoviePlaybackFinishedHandle;
+};
@@ -0,0 +1,210 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenImageStreamer.h"
+#include "Slate/DeferredCleanupSlateBrush.h"
+#include "Engine/Texture2D.h"
+#include "Containers/Ticker.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectGlobals.h"
+#include "CustomMoviePlayer.h"
+
+FLoadingScreenImageStreamer::FLoadingScreenImageStreamer(const FImageSequenceSettings& InImageSequenceSettings)
+	: ImageSequenceSettings(InImageSequenceSettings)
+{
+	// The game thread can't follow a playhead advancing every paint, step at most once per frame at 60 fps
+	Interval = FMath::Max(ImageSequenceSettings.Interval, 1.0f / 60.0f);
+	WindowSize = FMath::Max(ImageSequenceSettings.StreamingWindowSize, 1);
+}
+
+FLoadingScreenImageStreamer::~FLoadingScreenImageStreamer()
+{
+	FCoreDelegates::OnAsyncLoadingFlushUpdate.Remove(AsyncLoadingFlushUpdateHandle);
+	FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	if (LastPaintedStep >= 0)
+	{
+		UE_LOG(LogMoviePlayer, Log, TEXT("Streamed loading screen image sequence dropped %d of %lld images waiting on IO (window of %d images)"), NumDroppedFrames, LastPaintedStep + 1, WindowSize);
+	}
+}
+
+void FLoadingScreenImageStreamer::Start()
+{
+	check(IsInGameThread());
+
+	StartTime = FPlatformTime::Seconds();
+
+	// Loading a map blocks the game thread in FlushAsyncLoading, which only lets the window move through its update delegate and the load callbacks
+	AsyncLoadingFlushUpdateHandle = FCoreDelegates::OnAsyncLoadingFlushUpdate.AddThreadSafeSP(this, &FLoadingScreenImageStreamer::UpdateWindow);
+	TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateThreadSafeSP(this, &FLoadingScreenImageStreamer::Tick));
+
+	UpdateWindow();
+}
+
+int64 FLoadingScreenImageStreamer::GetStep(double Time) const
+{
+	return FMath::Max<int64>((int64)FMath::FloorToDouble((Time - StartTime) / Interval), 0);
+}
+
+int32 FLoadingScreenImageStreamer::GetFrameIndex(int64 Step) const
+{
+	const int32 NumFrames = GetNumFrames();
+	const int32 FrameIndex = (int32)(Step % NumFrames);
+	return ImageSequenceSettings.bPlayReverse ? NumFrames - 1 - FrameIndex : FrameIndex;
+}
+
+bool FLoadingScreenImageStreamer::Tick(float DeltaTime)
+{
+	UpdateWindow();
+	return true;
+}
+
+void FLoadingScreenImageStreamer::UpdateWindow()
+{
+	check(IsInGameThread());
+
+	if (GetNumFrames() == 0)
+	{
+		return;
+	}
+
+	const int64 Step = GetStep(FPlatformTime::Seconds());
+
+	TSet<int32> WindowFrames;
+	for (int64 WindowStep = Step; WindowStep < Step + WindowSize && WindowFrames.Num() < GetNumFrames(); ++WindowStep)
+	{
+		WindowFrames.Add(GetFrameIndex(WindowStep));
+	}
+
+	FScopeLock WindowLock(&CriticalSection);
+
+	// The image on screen stays loaded however many images were dropped since, it is shown again while the next one is late
+	if (ShownFrameIndex != INDEX_NONE)
+	{
+		WindowFrames.Add(ShownFrameIndex);
+	}
+
+	for (auto It = LoadedFrames.CreateIterator(); It; ++It)
+	{
+		if (!WindowFrames.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (int32 FrameIndex : WindowFrames)
+	{
+		if (!LoadedFrames.Contains(FrameIndex) && !RequestedFrames.Contains(FrameIndex))
+		{
+			RequestFrame(FrameIndex);
+		}
+	}
+}
+
+void FLoadingScreenImageStreamer::RequestFrame(int32 FrameIndex)
+{
+	const TSoftObjectPtr<UTexture2D>& Image = ImageSequenceSettings.Images[FrameIndex];
+	if (Image.IsNull())
+	{
+		return;
+	}
+
+	if (Image.IsValid())
+	{
+		OnFrameLoaded(FrameIndex);
+		return;
+	}
+
+	// Ahead of the level packages, a late image shows up as a stutter
+	const int32 ImagePackagePriority = 100;
+
+	RequestedFrames.Add(FrameIndex);
+
+	TWeakPtr<FLoadingScreenImageStreamer, ESPMode::ThreadSafe> WeakStreamer = AsShared();
+	LoadPackageAsync(Image.ToSoftObjectPath().GetLongPackageName(), FLoadPackageAsyncDelegate::CreateLambda(
+		[WeakStreamer, FrameIndex](const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+		{
+			if (TSharedPtr<FLoadingScreenImageStreamer, ESPMode::ThreadSafe> Streamer = WeakStreamer.Pin())
+			{
+				Streamer->OnFrameLoaded(FrameIndex);
+				Streamer->UpdateWindow();
+			}
+		}), ImagePackagePriority);
+}
+
+void FLoadingScreenImageStreamer::OnFrameLoaded(int32 FrameIndex)
+{
+	check(IsInGameThread());
+
+	FScopeLock WindowLock(&CriticalSection);
+
+	RequestedFrames.Remove(FrameIndex);
+
+	UTexture2D* Image = ImageSequenceSettings.Images[FrameIndex].Get();
+	if (!Image)
+	{
+		return;
+	}
+
+	const FVector2D Scale = ImageSequenceSettings.Scale;
+	const FVector2D ImageSize(Image->GetSurfaceWidth() * Scale.X, Image->GetSurfaceHeight() * Scale.Y);
+	LoadedFrames.Add(FrameIndex, FDeferredCleanupSlateBrush::CreateBrush(Image, ImageSize));
+
+	if (FrameSize.IsZero())
+	{
+		FrameSize = ImageSize;
+	}
+}
+
+bool FLoadingScreenImageStreamer::GetFrameBrush(double CurrentTime, FSlateBrush& OutBrush)
+{
+	if (GetNumFrames() == 0)
+	{
+		return false;
+	}
+
+	const int64 Step = GetStep(CurrentTime);
+
+	FScopeLock WindowLock(&CriticalSection);
+
+	const int32 FrameIndex = GetFrameIndex(Step);
+	const TSharedPtr<FDeferredCleanupSlateBrush>* FrameBrush = LoadedFrames.Find(FrameIndex);
+	if (FrameBrush && FrameBrush->IsValid())
+	{
+		ShownBrush = *FrameBrush;
+		ShownFrameIndex = FrameIndex;
+	}
+	else if (ShownBrush.IsValid() && Step != LastDroppedStep)
+	{
+		// The images missing before the first one arrived are the start up latency, not drops
+		LastDroppedStep = Step;
+		++NumDroppedFrames;
+		UE_LOG(LogMoviePlayer, Verbose, TEXT("Loading screen image %d wasn't streamed in on time, %d images dropped so far"), FrameIndex, NumDroppedFrames);
+	}
+
+	LastPaintedStep = Step;
+	if (!ShownBrush.IsValid())
+	{
+		return false;
+	}
+
+	OutBrush = *ShownBrush->GetSlateBrush();
+	return true;
+}
+
+double FLoadingScreenImageStreamer::GetNextFrameTime(double CurrentTime) const
+{
+	return StartTime + (GetStep(CurrentTime) + 1) * (double)Interval;
+}
+
+FVector2D FLoadingScreenImageStreamer::GetFrameSize() const
+{
+	FScopeLock WindowLock(&CriticalSection);
+	return FrameSize;
+}
@@ -0,0 +1,94 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Styling/SlateBrush.h"
+#include "LoadingScreenSettings.h"
+
+class FDeferredCleanupSlateBrush;
+
+/**
+ * Streams the images of a long image sequence through a window around the playhead.
+ * The game thread loads the upcoming images and releases the ones behind the playhead, the thread painting the loading screen only reads the window.
+ * The playhead moves with time, so both threads agree on it without talking to each other.
+ */
+class FLoadingScreenImageStreamer : public TSharedFromThis<FLoadingScreenImageStreamer, ESPMode::ThreadSafe>
+{
+public:
+	FLoadingScreenImageStreamer(const FImageSequenceSettings& InImageSequenceSettings);
+	~FLoadingScreenImageStreamer();
+
+	/** Starts the playhead and the prefetching, on the game thread */
+	void Start();
+
+	/** Gets the brush of the image shown at CurrentTime, the last image shown when it isn't loaded in time. Returns false before any image is loaded. */
+	bool GetFrameBrush(double CurrentTime, FSlateBrush& OutBrush);
+
+	/** Next time the image changes at */
+	double GetNextFrameTime(double CurrentTime) const;
+
+	/** Drawn size of an image, zero until the first image is loaded */
+	FVector2D GetFrameSize() const;
+
+	int32 GetNumFrames() const { return ImageSequenceSettings.Images.Num(); }
+
+private:
+	/** Number of steps the playhead has moved since the start */
+	int64 GetStep(double Time) const;
+
+	/** Image shown at the given step */
+	int32 GetFrameIndex(int64 Step) const;
+
+	/** Requests the images of the window that aren't loaded yet and releases the others, on the game thread */
+	void UpdateWindow();
+
+	/** Loads the package of an image, the brush is created once it's loaded */
+	void RequestFrame(int32 FrameIndex);
+
+	/** Creates the brush of a loaded image if it's still in the window */
+	void OnFrameLoaded(int32 FrameIndex);
+
+	/** Ticks the window while the game thread is not waiting on async loading */
+	bool Tick(float DeltaTime);
+
+	FImageSequenceSettings ImageSequenceSettings;
+
+	// Time in second each image is shown
+	float Interval = 0.05f;
+
+	// Number of upcoming images kept loaded
+	int32 WindowSize = 8;
+
+	// Time the playhead started at
+	double StartTime = 0.0;
+
+	// Guards the window, it is read while painting
+	mutable FCriticalSection CriticalSection;
+
+	// Brushes of the loaded images of the window
+	TMap<int32, TSharedPtr<FDeferredCleanupSlateBrush>> LoadedFrames;
+
+	// Images whose package is being loaded
+	TSet<int32> RequestedFrames;
+
+	// Brush of the image on screen, shown again while the next image is late. It keeps its image loaded, and the image stays in the window
+	TSharedPtr<FDeferredCleanupSlateBrush> ShownBrush;
+	int32 ShownFrameIndex = INDEX_NONE;
+
+	FVector2D FrameSize = FVector2D::ZeroVector;
+
+	// Steps whose image wasn't loaded when it was due
+	int32 NumDroppedFrames = 0;
+	int64 LastDroppedStep = INDEX_NONE;
+	int64 LastPaintedStep = INDEX_NONE;
+
+	FDelegateHandle AsyncLoadingFlushUpdateHandle;
+	FDelegateHandle TickerHandle;
+};
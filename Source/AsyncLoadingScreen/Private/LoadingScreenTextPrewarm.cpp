@@ -0,0 +1,69 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenTextPrewarm.h"
+#include "LoadingScreenSettings.h"
+#include "CustomMoviePlayer.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Rendering/SlateRenderer.h"
+#include "Fonts/FontCache.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/UserInterfaceSettings.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarAsyncLoadingScreenPrewarmTextGlyphs(
+	TEXT("AsyncLoadingScreen.PrewarmTextGlyphs"),
+	-1,
+	TEXT("Rasterize the glyphs of the tip, loading and loading complete texts while the loading screen is set up instead of on its first paint.\n")
+	TEXT("< 0: use Performance.bPrewarmTextGlyphs from the project settings (default), 0: disable, 1: enable"),
+	ECVF_Default);
+
+void FLoadingScreenTextPrewarm::Prewarm(const FText& Text, const FSlateFontInfo& Font)
+{
+	const int32 PrewarmOverride = CVarAsyncLoadingScreenPrewarmTextGlyphs.GetValueOnGameThread();
+	const bool bPrewarm = PrewarmOverride >= 0 ? PrewarmOverride != 0 : GetDefault<ULoadingScreenSettings>()->Performance.bPrewarmTextGlyphs;
+
+	// The font cache is shared with the loading thread once the loading screen is up, only touch it before
+	if (!bPrewarm || Text.IsEmpty() || !Font.HasValidFont() || !IsInGameThread() || !FSlateApplication::IsInitialized() || !FSlateApplication::Get().GetRenderer())
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Glyphs are cached per font scale, the loading screen is drawn at the DPI scale of the viewport
+	float FontScale = 1.0f;
+	if (GEngine && GEngine->GameViewport)
+	{
+		FVector2D ViewportSize;
+		GEngine->GameViewport->GetViewportSize(ViewportSize);
+		if (!ViewportSize.IsNearlyZero())
+		{
+			FontScale = GetDefault<UUserInterfaceSettings>()->GetDPIScaleBasedOnSize(FIntPoint((int32)ViewportSize.X, (int32)ViewportSize.Y));
+		}
+	}
+
+	TSharedRef<FSlateFontCache> FontCache = FSlateApplication::Get().GetRenderer()->GetFontCache();
+
+	// Wrapping only changes where the lines break, not the glyphs, the whole text is shaped at once
+	FShapedGlyphSequenceRef ShapedText = FontCache->ShapeBidirectionalText(Text.ToString(), Font, FontScale, TextBiDi::ETextDirection::LeftToRight, ETextShapingMethod::Auto);
+
+	int32 NumGlyphs = 0;
+	for (const FShapedGlyphEntry& Glyph : ShapedText->GetGlyphsToRender())
+	{
+		if (Glyph.bIsVisible)
+		{
+			FontCache->GetShapedGlyphFontAtlasData(Glyph, Font.OutlineSettings);
+			++NumGlyphs;
+		}
+	}
+
+	UE_LOG(LogMoviePlayer, Verbose, TEXT("Prewarmed %d glyphs of \"%s\" at font size %d and scale %.2f in %.2f ms"),
+		NumGlyphs, *Text.ToString().Left(32), Font.Size, FontScale, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
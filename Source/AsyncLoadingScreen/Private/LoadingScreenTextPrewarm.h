@@ -0,0 +1,23 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Fonts/SlateFontInfo.h"
+
+/**
+ * Shapes loading screen texts and rasterizes their glyphs into the Slate font cache while the loading screen is set up,
+ * so the loading thread doesn't hit FreeType on its first paint. Only used on the game thread.
+ */
+class FLoadingScreenTextPrewarm
+{
+public:
+	/** Caches the glyphs of Text drawn with Font at the DPI scale of the game viewport, unless disabled in the performance settings */
+	static void Prewarm(const FText& Text, const FSlateFontInfo& Font);
+};
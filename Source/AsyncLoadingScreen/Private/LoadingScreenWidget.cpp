@@ -8,6 +8,9 @@
 #include "SLetterboxLayout.h"
 #include "SSidebarLayout.h"
 #include "SDualSidebarLayout.h"
+#include "SCustomWidgetLayout.h"
+#include "LoadingScreenRedrawMetaData.h"
+#include "AsyncLoadingScreenTrace.h"
 
 //#if WITH_EDITOR
 //#pragma optimize("", off)
@@ -21,6 +24,8 @@ void ULoadingScreenWidget::SynchronizeProperties()
 
 TSharedPtr<SWidget> ULoadingScreenWidget::CreateSlateWidget(const FALoadingScreenSettings& loading_settings)
 {
+	ASYNC_LOADING_SCREEN_TRACE_SCOPE(CreateSlateWidget);
+
 	TSharedPtr<SWidget> loading_widget;
 
 	const ULoadingScreenSettings* settings{GetDefault<ULoadingScreenSettings>()};
@@ -44,28 +49,17 @@ TSharedPtr<SWidget> ULoadingScreenWidget::CreateSlateWidget(const FALoadingScree
 	case EAsyncLoadingScreenLayout::ALSL_CustomWidget:
 		if (GEngine && loading_settings.CustomLoadingWidget.IsNull() == false)
 		{
-			UUserWidget* new_widget{NewObject<UUserWidget>(GEngine, loading_settings.CustomLoadingWidget.LoadSynchronous(), TEXT("LoadingScreen"), RF_Transactional)};
-			new_widget->Initialize();
-			//UUserWidget* new_widget{CreateWidget<UUserWidget>(GEngine->GetWorld(), loading_settings.CustomLoadingWidget.LoadSynchronous())};
-
-			// Root widget and background
-			loading_widget = SNew(SOverlay)
-				+ SOverlay::Slot()
-				.HAlign(HAlign_Fill)
-				.VAlign(VAlign_Fill)
-				[
-					SNew(SScaleBox)
-					.Stretch(loading_settings.Background.ImageStretch)
-					[
-						new_widget->TakeWidget()
-					]
-				];
-
-			//loading_widget = new_widget->TakeWidget();
+			loading_widget = SNew(SCustomWidgetLayout, loading_settings);
 		}
 		break;
 	}
 
+	// All the animated widgets of the built-in layouts report when they have to be repainted
+	if (loading_widget.IsValid() && loading_settings.Layout != EAsyncLoadingScreenLayout::ALSL_CustomWidget)
+	{
+		loading_widget->AddMetadata(MakeShared<FLoadingScreenRedrawMetaData>());
+	}
+
 	return loading_widget;
 }
 
@@ -13,6 +13,28 @@
 #include "Widgets/Layout/SBorder.h"
 #include "Engine/Texture2D.h"
 #include "AsyncLoadingScreenLibrary.h"
+#include "LoadingScreenRedrawMetaData.h"
+#include "Widgets/Layout/SScaleBox.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectGlobals.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "CustomMoviePlayer.h"
+#include "LoadingScreenAssetCache.h"
+#include "Async/Async.h"
+
+/** Longest time in second a loaded background waits for its mips to stream in before it's shown anyway */
+static const double MaxMipStreamingWaitTime = 1.0;
+
+/** Top mips limit of a texture shown by backgrounds, see SBackgroundWidget::AcquireMipLimit */
+struct FBackgroundMipLimit
+{
+	int32 NumBackgrounds = 0;
+	int32 OriginalLODBias = 0;
+};
+
+/** Textures whose top mips are limited, only used on the game thread */
+static TMap<TWeakObjectPtr<UTexture2D>, FBackgroundMipLimit> BackgroundMipLimits;
 
 void SBackgroundWidget::Construct(const FArguments& InArgs, const FBackgroundSettings& Settings)
 {
@@ -30,27 +52,327 @@ void SBackgroundWidget::Construct(const FArguments& InArgs, const FBackgroundSet
 		}
 
 		const FSoftObjectPath& ImageAsset = Settings.Images[ImageIndex];
-		UObject* ImageObject = ImageAsset.TryLoad();
+		FadeInTime = Settings.FadeInTime;
+
+		// Async loading is only ticked once the engine is up, the startup loading screen has to load synchronously
+		UObject* ImageObject = ImageAsset.ResolveObject();
+		if (ImageObject == nullptr && !(Settings.bLoadAsynchronously && GEngine && GEngine->IsInitialized()))
+		{
+			ImageObject = ImageAsset.TryLoad();
+		}
+
 		if (UTexture2D* LoadingImage = Cast<UTexture2D>(ImageObject))
 		{
-			ImageBrush = FDeferredCleanupSlateBrush::CreateBrush(LoadingImage);
-			ChildSlot
+			FLoadingScreenAssetCache::Get().Pin(FLoadingScreenAssetCache::Get().GetCurrentScreenName(), LoadingImage);
+
+			// An already loaded texture may still be streaming the mips it's drawn with, it fades in once they are resident
+			PendingImage = MakeShared<FPendingImage, ESPMode::ThreadSafe>();
+			PendingImage->RequestTime = FPlatformTime::Seconds();
+			SetPendingTexture(*PendingImage, LoadingImage, Settings.ImageStretch);
+			if (PendingImage->bMipLimited)
+			{
+				MipLimitedTexture = LoadingImage;
+				PendingImage->bMipLimited = false;
+			}
+
+			if (PendingImage->WantedMips <= LoadingImage->GetNumResidentMips())
+			{
+				ImageBrush = MoveTemp(PendingImage->Brush);
+				PendingImage.Reset();
+			}
+			else
+			{
+				FadeInAlpha = 0.0f;
+			}
+		}
+		else if (ImageObject == nullptr && !ImageAsset.IsNull())
+		{
+			RequestImageAsync(ImageAsset, Settings.ImageStretch);
+		}
+		else
+		{
+			return;
+		}
+
+		ChildSlot
+		[
+			SNew(SBorder)
+			.HAlign(HAlign_Fill)
+			.VAlign(VAlign_Fill)
+			.Padding(Settings.Padding)
+			.BorderBackgroundColor(Settings.BackgroundColor)
+			.BorderImage(FCoreStyle::Get().GetBrush("WhiteBrush"))
 			[
-				SNew(SBorder)
-				.HAlign(HAlign_Fill)
-				.VAlign(VAlign_Fill)
-				.Padding(Settings.Padding)
-				.BorderBackgroundColor(Settings.BackgroundColor)
-				.BorderImage(FCoreStyle::Get().GetBrush("WhiteBrush"))
+				SNew(SScaleBox)
+				.Stretch(Settings.ImageStretch)
 				[
-					SNew(SScaleBox)
-					.Stretch(Settings.ImageStretch)
-					[
-						SNew(SImage)						
-						.Image(ImageBrush.IsValid() ? ImageBrush->GetSlateBrush() : nullptr)						
-					]
+					SNew(SImage)						
+					.Image(this, &SBackgroundWidget::GetImageBrush)
+					.ColorAndOpacity(this, &SBackgroundWidget::GetImageColor)
 				]
-			];			
+			]
+		];
+
+		// Let the custom loading screen thread know when the image arrives and fades in
+		AddMetadata(MakeShared<FLoadingScreenRedrawMetaData>(FLoadingScreenRedrawMetaData::FGetNextPaintTime::CreateSP(this, &SBackgroundWidget::GetNextPaintTime)));
+	}
+
+	// Only the pending image needs ticking, and painting out of the cached layers of the layout until it has faded in
+	SetCanTick(PendingImage.IsValid());
+	ForceVolatile(PendingImage.IsValid());
+}
+
+SBackgroundWidget::~SBackgroundWidget()
+{
+	// A background that arrived but was never picked up by Tick still holds its limit, one arriving later doesn't take any
+	if (PendingImage.IsValid())
+	{
+		FScopeLock PendingImageLock(&PendingImage->CriticalSection);
+		PendingImage->bWidgetDestroyed = true;
+		if (PendingImage->bMipLimited)
+		{
+			MipLimitedTexture = PendingImage->Texture;
+			PendingImage->bMipLimited = false;
+		}
+	}
+
+	if (!MipLimitedTexture.IsExplicitlyNull())
+	{
+		ReleaseMipLimit(MipLimitedTexture);
+	}
+}
+
+void SBackgroundWidget::RequestImageAsync(const FSoftObjectPath& ImageAsset, EStretch::Type ImageStretch)
+{
+	// Ahead of the level packages so the image shows up as early as possible
+	const int32 ImagePackagePriority = 100;
+
+	PendingImage = MakeShared<FPendingImage, ESPMode::ThreadSafe>();
+	PendingImage->RequestTime = FPlatformTime::Seconds();
+	FadeInAlpha = 0.0f;
+
+	TSharedRef<FPendingImage, ESPMode::ThreadSafe> InPendingImage = PendingImage.ToSharedRef();
+	const FSoftObjectPath InImageAsset = ImageAsset;
+	const FName CachedScreenName = FLoadingScreenAssetCache::Get().GetCurrentScreenName();
+	LoadPackageAsync(ImageAsset.GetLongPackageName(), FLoadPackageAsyncDelegate::CreateLambda(
+		[InPendingImage, InImageAsset, ImageStretch, CachedScreenName](const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+		{
+			// Called on the game thread, the widget may already be gone and is painted on another thread anyway
+			UTexture2D* LoadedImage = Cast<UTexture2D>(InImageAsset.ResolveObject());
+			FLoadingScreenAssetCache::Get().Pin(CachedScreenName, LoadedImage);
+			SetPendingTexture(*InPendingImage, LoadedImage, ImageStretch);
+		}), ImagePackagePriority);
+}
+
+void SBackgroundWidget::SetPendingTexture(FPendingImage& InPendingImage, UTexture2D* Texture, EStretch::Type ImageStretch)
+{
+	TSharedPtr<FDeferredCleanupSlateBrush> LoadedBrush;
+	if (Texture)
+	{
+		LoadedBrush = FDeferredCleanupSlateBrush::CreateBrush(Texture);
+	}
+
+	// The widget may be destroyed on the thread painting the loading screen, holding the lock keeps it from going away before it owns the limit
+	FScopeLock PendingImageLock(&InPendingImage.CriticalSection);
+	if (Texture && !InPendingImage.bWidgetDestroyed)
+	{
+		InPendingImage.WantedMips = RequestMipResidency(Texture, ImageStretch);
+		InPendingImage.bMipLimited = AcquireMipLimit(Texture, InPendingImage.WantedMips);
+	}
+	InPendingImage.Brush = MoveTemp(LoadedBrush);
+	InPendingImage.Texture = Texture;
+	InPendingImage.bArrived = true;
+}
+
+int32 SBackgroundWidget::RequestMipResidency(UTexture2D* Texture, EStretch::Type ImageStretch)
+{
+	check(IsInGameThread());
+
+	FVector2D ViewportSize = FVector2D::ZeroVector;
+	if (GEngine && GEngine->GameViewport)
+	{
+		GEngine->GameViewport->GetViewportSize(ViewportSize);
+	}
+
+	const int32 NumMips = Texture->GetNumMips();
+	if (ViewportSize.IsNearlyZero() || NumMips <= 1 || Texture->GetSizeX() <= 0 || Texture->GetSizeY() <= 0)
+	{
+		return 0;
+	}
+
+	// Scale the top mip is drawn at, the background fills the viewport
+	const FVector2D Scale = ViewportSize / FVector2D(Texture->GetSizeX(), Texture->GetSizeY());
+	float DrawScale = 1.0f;
+	switch (ImageStretch)
+	{
+	case EStretch::ScaleToFit:
+		DrawScale = FMath::Min(Scale.X, Scale.Y);
+		break;
+	case EStretch::ScaleToFitX:
+		DrawScale = Scale.X;
+		break;
+	case EStretch::ScaleToFitY:
+		DrawScale = Scale.Y;
+		break;
+	case EStretch::Fill:
+	case EStretch::ScaleToFill:
+		DrawScale = FMath::Max(Scale.X, Scale.Y);
+		break;
+	default:
+		break;
+	}
+
+	// Each mip dropped halves the size, keep the smallest mip still at least as large as it's drawn
+	const int32 NumUnusedMips = DrawScale < 1.0f ? FMath::Clamp(FMath::FloorToInt(-FMath::Log2(DrawScale)), 0, NumMips - 1) : 0;
+	const int32 WantedMips = NumMips - NumUnusedMips;
+	const int32 NumResidentMips = Texture->GetNumResidentMips();
+
+	if (Texture->IsStreamable())
+	{
+		// The streamer isn't updated while the game thread is loading, ask for exactly the mips the background is drawn with right away
+		int64 FreedSize = 0;
+		if (NumResidentMips < WantedMips)
+		{
+			Texture->StreamIn(WantedMips, true);
+		}
+		else if (NumResidentMips > WantedMips && Texture->StreamOut(WantedMips))
+		{
+			FreedSize = Texture->CalcTextureMemorySize(NumResidentMips) - Texture->CalcTextureMemorySize(WantedMips);
+		}
+
+		UE_LOG(LogMoviePlayer, Verbose, TEXT("Background %s is drawn at %.0f%% on a %.0fx%.0f viewport, %d of %d mips wanted (%d resident, %.1f MB of top mips freed)"),
+			*Texture->GetName(), DrawScale * 100.0f, ViewportSize.X, ViewportSize.Y, WantedMips, NumMips, NumResidentMips, FreedSize / (1024.0 * 1024.0));
+	}
+	else if (NumUnusedMips > 0)
+	{
+		// Never streamed textures keep all their mips, only worth a hint
+		UE_LOG(LogMoviePlayer, Verbose, TEXT("Background %s isn't streamable and keeps %.1f MB of top mips it never draws on a %.0fx%.0f viewport"),
+			*Texture->GetName(), (Texture->CalcTextureMemorySize(NumMips) - Texture->CalcTextureMemorySize(WantedMips)) / (1024.0 * 1024.0), ViewportSize.X, ViewportSize.Y);
+	}
+
+	return WantedMips;
+}
+
+bool SBackgroundWidget::AcquireMipLimit(UTexture2D* Texture, int32 WantedMips)
+{
+	check(IsInGameThread());
+
+	const int32 NumUnusedMips = Texture->GetNumMips() - WantedMips;
+	if (!Texture->IsStreamable() || WantedMips <= 0 || NumUnusedMips <= 0)
+	{
+		return false;
+	}
+
+	// The streamer never streams in the top mips dropped by the LOD bias of the texture, backgrounds showing the same texture share the first limit
+	FBackgroundMipLimit& MipLimit = BackgroundMipLimits.FindOrAdd(Texture);
+	if (MipLimit.NumBackgrounds++ == 0)
+	{
+		MipLimit.OriginalLODBias = Texture->LODBias;
+		Texture->LODBias = FMath::Max(Texture->LODBias, NumUnusedMips);
+		Texture->UpdateCachedLODBias();
+	}
+	return true;
+}
+
+void SBackgroundWidget::ReleaseMipLimit(const TWeakObjectPtr<UTexture2D>& Texture)
+{
+	if (!IsInGameThread())
+	{
+		AsyncTask(ENamedThreads::GameThread, [Texture]() { ReleaseMipLimit(Texture); });
+		return;
+	}
+
+	FBackgroundMipLimit* MipLimit = BackgroundMipLimits.Find(Texture);
+	if (!MipLimit || --MipLimit->NumBackgrounds > 0)
+	{
+		return;
+	}
+
+	if (UTexture2D* LimitedTexture = Texture.Get())
+	{
+		LimitedTexture->LODBias = MipLimit->OriginalLODBias;
+		LimitedTexture->UpdateCachedLODBias();
+	}
+	BackgroundMipLimits.Remove(Texture);
+}
+
+void SBackgroundWidget::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	if (PendingImage.IsValid() && !ImageBrush.IsValid())
+	{
+		bool bArrived = false;
+		{
+			FScopeLock PendingImageLock(&PendingImage->CriticalSection);
+			const double CurrentTime = FPlatformTime::Seconds();
+
+			// Keep showing the background color until the mips it's drawn with are resident rather than showing a blurry image
+			const bool bMipsResident = !PendingImage->Texture || PendingImage->Texture->GetNumResidentMips() >= PendingImage->WantedMips;
+			if (PendingImage->bArrived && (bMipsResident || CurrentTime - PendingImage->RequestTime >= MaxMipStreamingWaitTime))
+			{
+				bArrived = true;
+				ImageBrush = MoveTemp(PendingImage->Brush);
+				if (PendingImage->bMipLimited)
+				{
+					MipLimitedTexture = PendingImage->Texture;
+					PendingImage->bMipLimited = false;
+				}
+				if (ImageBrush.IsValid())
+				{
+					UE_LOG(LogMoviePlayer, Verbose, TEXT("Background %s shown %.0f ms after it was requested, %s"), *PendingImage->Texture->GetName(),
+						(CurrentTime - PendingImage->RequestTime) * 1000.0, bMipsResident ? TEXT("sharp") : TEXT("still streaming its mips"));
+				}
+			}
+		}
+
+		if (bArrived && !ImageBrush.IsValid())
+		{
+			// Failed to load, keep showing the background color
+			PendingImage.Reset();
+		}
+	}
+
+	if (ImageBrush.IsValid() && PendingImage.IsValid())
+	{
+		FadeInAlpha = FadeInTime > 0.0f ? FMath::Min(FadeInAlpha + InDeltaTime / FadeInTime, 1.0f) : 1.0f;
+		if (FadeInAlpha >= 1.0f)
+		{
+			PendingImage.Reset();
+		}
+	}
+
+	if (!PendingImage.IsValid())
+	{
+		// Done, go back to the cached layers
+		SetCanTick(false);
+		ForceVolatile(false);
+	}
+}
+
+double SBackgroundWidget::GetNextPaintTime(double CurrentTime) const
+{
+	if (PendingImage.IsValid())
+	{
+		if (ImageBrush.IsValid())
+		{
+			// Fading in
+			return CurrentTime;
 		}
+
+		FScopeLock PendingImageLock(&PendingImage->CriticalSection);
+		return PendingImage->bArrived ? CurrentTime : MAX_dbl;
 	}
+
+	return MAX_dbl;
+}
+
+const FSlateBrush* SBackgroundWidget::GetImageBrush() const
+{
+	return ImageBrush.IsValid() ? ImageBrush->GetSlateBrush() : nullptr;
+}
+
+FSlateColor SBackgroundWidget::GetImageColor() const
+{
+	return FLinearColor(1.0f, 1.0f, 1.0f, FadeInAlpha);
 }
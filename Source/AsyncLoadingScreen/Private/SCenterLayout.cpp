@@ -124,6 +124,6 @@ void SCenterLayout::Construct(const FArguments& InArgs, const FALoadingScreenSet
 	// Add root to this widget
 	ChildSlot
 	[
-		Root
+		MakeCachedLayout(Root)
 	];
 }
@@ -156,6 +156,6 @@ void SClassicLayout::Construct(const FArguments& InArgs, const FALoadingScreenSe
 	// Add root to this widget
 	ChildSlot
 	[
-		Root
+		MakeCachedLayout(Root)
 	];
 }
@@ -0,0 +1,210 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "SCustomWidgetLayout.h"
+#include "LoadingScreenSettings.h"
+#include "LoadingScreenWidget.h"
+#include "LoadingScreenAssetCache.h"
+#include "Blueprint/UserWidget.h"
+#include "Widgets/SOverlay.h"
+#include "Engine/Engine.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	/** A custom widget class being loaded, or loaded ahead of its loading screen */
+	struct FWidgetClassRequest
+	{
+		TStrongObjectPtr<UClass> WidgetClass;
+		TArray<TFunction<void(UClass*)>> OnLoaded;
+		bool bLoaded = false;
+	};
+
+	/** Requests by class path, only used on the game thread */
+	TMap<FSoftObjectPath, TSharedRef<FWidgetClassRequest>> WidgetClassRequests;
+
+	TSharedRef<FWidgetClassRequest> FindOrRequestWidgetClass(const TSoftClassPtr<UUserWidget>& WidgetClass)
+	{
+		check(IsInGameThread());
+
+		const FSoftObjectPath ClassPath = WidgetClass.ToSoftObjectPath();
+		if (const TSharedRef<FWidgetClassRequest>* ExistingRequest = WidgetClassRequests.Find(ClassPath))
+		{
+			return *ExistingRequest;
+		}
+
+		TSharedRef<FWidgetClassRequest> Request = MakeShared<FWidgetClassRequest>();
+		WidgetClassRequests.Add(ClassPath, Request);
+
+		// Ahead of the level packages, the fallback layout is shown until then
+		const int32 WidgetClassPackagePriority = 100;
+
+		LoadPackageAsync(ClassPath.GetLongPackageName(), FLoadPackageAsyncDelegate::CreateLambda(
+			[ClassPath, WidgetClass](const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+			{
+				const TSharedRef<FWidgetClassRequest>* FoundRequest = WidgetClassRequests.Find(ClassPath);
+				if (!FoundRequest)
+				{
+					// Released on shutdown
+					return;
+				}
+
+				TSharedRef<FWidgetClassRequest> LoadedRequest = *FoundRequest;
+				LoadedRequest->bLoaded = true;
+				LoadedRequest->WidgetClass.Reset(WidgetClass.Get());
+
+				if (!WidgetClass.Get())
+				{
+					UE_LOG(LogSlate, Warning, TEXT("Failed to load the custom loading screen widget %s, keeping the fallback layout"), *ClassPath.ToString());
+				}
+
+				// A preloaded class stays loaded until a layout asks for it, otherwise the waiting layouts take it now
+				if (LoadedRequest->OnLoaded.Num() > 0)
+				{
+					WidgetClassRequests.Remove(ClassPath);
+
+					for (const TFunction<void(UClass*)>& OnLoaded : LoadedRequest->OnLoaded)
+					{
+						OnLoaded(WidgetClass.Get());
+					}
+				}
+			}), WidgetClassPackagePriority);
+
+		return Request;
+	}
+}
+
+void SCustomWidgetLayout::Construct(const FArguments& InArgs, const FALoadingScreenSettings& Settings)
+{
+	const TSoftClassPtr<UUserWidget>& WidgetClass = Settings.CustomLoadingWidget;
+	const EStretch::Type ImageStretch = Settings.Background.ImageStretch;
+
+	// Take the class over from PreloadWidgetClass if it's already loaded
+	UClass* LoadedWidgetClass = WidgetClass.Get();
+	if (const TSharedRef<FWidgetClassRequest>* Request = WidgetClassRequests.Find(WidgetClass.ToSoftObjectPath()))
+	{
+		if ((*Request)->bLoaded)
+		{
+			LoadedWidgetClass = (*Request)->WidgetClass.Get();
+			WidgetClassRequests.Remove(WidgetClass.ToSoftObjectPath());
+		}
+	}
+
+	// Async loading is only ticked once the engine is up
+	if (LoadedWidgetClass || !Settings.bLoadCustomWidgetAsynchronously || !(GEngine && GEngine->IsInitialized()))
+	{
+		if (!LoadedWidgetClass)
+		{
+			LoadedWidgetClass = WidgetClass.LoadSynchronous();
+		}
+
+		if (LoadedWidgetClass)
+		{
+			FLoadingScreenAssetCache::Get().Pin(FLoadingScreenAssetCache::Get().GetCurrentScreenName(), LoadedWidgetClass);
+
+			ChildSlot
+			[
+				MakeCustomWidget(LoadedWidgetClass, ImageStretch)
+			];
+		}
+		return;
+	}
+
+	FALoadingScreenSettings FallbackSettings = Settings;
+	FallbackSettings.Layout = Settings.CustomWidgetFallbackLayout == EAsyncLoadingScreenLayout::ALSL_CustomWidget ? EAsyncLoadingScreenLayout::ALSL_Classic : Settings.CustomWidgetFallbackLayout;
+
+	if (TSharedPtr<SWidget> FallbackLayout = ULoadingScreenWidget::CreateSlateWidget(FallbackSettings))
+	{
+		ChildSlot
+		[
+			FallbackLayout.ToSharedRef()
+		];
+	}
+
+	PendingWidget = MakeShared<FPendingWidget, ESPMode::ThreadSafe>();
+
+	TSharedRef<FPendingWidget, ESPMode::ThreadSafe> InPendingWidget = PendingWidget.ToSharedRef();
+	const FName CachedScreenName = FLoadingScreenAssetCache::Get().GetCurrentScreenName();
+	FindOrRequestWidgetClass(WidgetClass)->OnLoaded.Add([InPendingWidget, ImageStretch, CachedScreenName](UClass* InWidgetClass)
+	{
+		FLoadingScreenAssetCache::Get().Pin(CachedScreenName, InWidgetClass);
+
+		// Nothing to do if the class failed to load or the loading screen is already gone
+		if (!InWidgetClass || InPendingWidget.IsUnique())
+		{
+			return;
+		}
+
+		// The widget tree is built here on the game thread and only handed over once complete
+		TSharedPtr<SWidget> Widget = MakeCustomWidget(InWidgetClass, ImageStretch);
+
+		FScopeLock PendingWidgetLock(&InPendingWidget->CriticalSection);
+		InPendingWidget->Widget = MoveTemp(Widget);
+	});
+}
+
+void SCustomWidgetLayout::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SLoadingScreenLayout::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	if (PendingWidget.IsValid())
+	{
+		TSharedPtr<SWidget> Widget;
+		{
+			FScopeLock PendingWidgetLock(&PendingWidget->CriticalSection);
+			Widget = MoveTemp(PendingWidget->Widget);
+		}
+
+		if (Widget.IsValid())
+		{
+			ChildSlot
+			[
+				Widget.ToSharedRef()
+			];
+			PendingWidget.Reset();
+		}
+	}
+}
+
+TSharedRef<SWidget> SCustomWidgetLayout::MakeCustomWidget(UClass* WidgetClass, EStretch::Type ImageStretch)
+{
+	check(IsInGameThread());
+
+	UUserWidget* NewWidget = NewObject<UUserWidget>(GEngine, WidgetClass, TEXT("LoadingScreen"), RF_Transactional);
+	NewWidget->Initialize();
+
+	// Root widget and background
+	return SNew(SOverlay)
+		+ SOverlay::Slot()
+		.HAlign(HAlign_Fill)
+		.VAlign(VAlign_Fill)
+		[
+			SNew(SScaleBox)
+			.Stretch(ImageStretch)
+			[
+				NewWidget->TakeWidget()
+			]
+		];
+}
+
+void SCustomWidgetLayout::PreloadWidgetClass(const TSoftClassPtr<UUserWidget>& WidgetClass)
+{
+	if (WidgetClass.IsNull() || WidgetClass.IsValid() || !(GEngine && GEngine->IsInitialized()))
+	{
+		return;
+	}
+
+	FindOrRequestWidgetClass(WidgetClass);
+}
+
+void SCustomWidgetLayout::ReleasePreloadedWidgetClasses()
+{
+	WidgetClassRequests.Empty();
+}
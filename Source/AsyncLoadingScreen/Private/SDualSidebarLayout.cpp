@@ -167,6 +167,6 @@ void SDualSidebarLayout::Construct(const FArguments& InArgs, const FALoadingScre
 	// Add root to this widget
 	ChildSlot
 	[
-		Root
+		MakeCachedLayout(Root)
 	];
 }
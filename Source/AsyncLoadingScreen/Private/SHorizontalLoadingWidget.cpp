@@ -12,6 +12,7 @@
 #include "Widgets/Images/SImage.h"
 #include "Slate/DeferredCleanupSlateBrush.h"
 #include "Widgets/Text/STextBlock.h"
+#include "LoadingScreenTextPrewarm.h"
 
 void SHorizontalLoadingWidget::Construct(const FArguments& InArgs, const FLoadingWidgetSettings& Settings)
 {
@@ -32,6 +33,7 @@ void SHorizontalLoadingWidget::Construct(const FArguments& InArgs, const FLoadin
 	else
 	{
 		LoadingTextVisibility = EVisibility::SelfHitTestInvisible;
+		FLoadingScreenTextPrewarm::Prewarm(Settings.LoadingText, Settings.Appearance.Font);
 	}
 
 	// If loading text is on the right
@@ -163,6 +163,6 @@ void SLetterboxLayout::Construct(const FArguments& InArgs, const FALoadingScreen
 	// Add Root to this widget
 	ChildSlot
 		[
-			Root
+			MakeCachedLayout(Root)
 		];
 }
@@ -11,12 +11,16 @@
 #include "LoadingScreenSettings.h"
 #include "MoviePlayer.h"
 #include "Widgets/Text/STextBlock.h"
+#include "LoadingScreenRedrawMetaData.h"
+#include "LoadingScreenTextPrewarm.h"
 
 void SLoadingCompleteText::Construct(const FArguments& InArgs, const FLoadingCompleteTextSettings& CompleteTextSettings)
 {
 	CompleteTextColor = CompleteTextSettings.Appearance.ColorAndOpacity.GetSpecifiedColor();
 	CompleteTextAnimationSpeed = CompleteTextSettings.AnimationSpeed;
 
+	FLoadingScreenTextPrewarm::Prewarm(CompleteTextSettings.LoadingCompleteText, CompleteTextSettings.Appearance.Font);
+
 	ChildSlot
 	[
 		SNew(STextBlock)					
@@ -35,6 +39,12 @@ void SLoadingCompleteText::Construct(const FArguments& InArgs, const FLoadingCom
 		bIsActiveTimerRegistered = true;
 		RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateSP(this, &SLoadingCompleteText::AnimateText));
 	}
+
+	// The text fades and shows up when loading completes, keep it out of the cached layers of the layout
+	ForceVolatile(true);
+
+	// Let the custom loading screen thread know when the text shows up or animates
+	AddMetadata(MakeShared<FLoadingScreenRedrawMetaData>(FLoadingScreenRedrawMetaData::FGetNextPaintTime::CreateSP(this, &SLoadingCompleteText::GetNextPaintTime)));
 }
 
 EVisibility SLoadingCompleteText::GetLoadingCompleteTextVisibility() const
@@ -47,6 +57,18 @@ FSlateColor SLoadingCompleteText::GetLoadingCompleteTextColor() const
 	return CompleteTextColor;
 }
 
+double SLoadingCompleteText::GetNextPaintTime(double CurrentTime) const
+{
+	const bool bIsVisible = GetLoadingCompleteTextVisibility().IsVisible();
+	if (bIsVisible != bWasVisible)
+	{
+		bWasVisible = bIsVisible;
+		return CurrentTime;
+	}
+
+	return bIsVisible && bIsActiveTimerRegistered ? CurrentTime : MAX_dbl;
+}
+
 EActiveTimerReturnType SLoadingCompleteText::AnimateText(double InCurrentTime, float InDeltaTime)
 {
 	const float MinAlpha = 0.1f;
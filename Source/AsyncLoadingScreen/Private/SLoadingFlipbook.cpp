@@ -0,0 +1,237 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "SLoadingFlipbook.h"
+#include "Slate/DeferredCleanupSlateBrush.h"
+#include "LoadingScreenRedrawMetaData.h"
+#include "LoadingScreenImageStreamer.h"
+#include "CustomMoviePlayer.h"
+#include "Engine/Texture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "CanvasTypes.h"
+#include "CanvasItem.h"
+#include "RenderingThread.h"
+#include "UObject/Package.h"
+
+void SLoadingFlipbook::Construct(const FArguments& InArgs)
+{
+	Interval = InArgs._Interval;
+	bPlayReverse = InArgs._bPlayReverse;
+
+	// Let the custom loading screen thread know when the next image is due
+	AddMetadata(MakeShared<FLoadingScreenRedrawMetaData>(FLoadingScreenRedrawMetaData::FGetNextPaintTime::CreateSP(this, &SLoadingFlipbook::GetNextPaintTime)));
+}
+
+void SLoadingFlipbook::SetFrames(const TArray<TSharedPtr<FDeferredCleanupSlateBrush>>& InBrushes, const TArray<FBox2D>& InUVRegions, const FVector2D& InFrameSize)
+{
+	Brushes = InBrushes;
+	UVRegions = InUVRegions;
+	FrameSize = InFrameSize;
+
+	if (UVRegions.Num() > 0 && Brushes.Num() > 0 && Brushes[0].IsValid())
+	{
+		AtlasFrameBrush = *Brushes[0]->GetSlateBrush();
+	}
+
+	StartTime = FPlatformTime::Seconds();
+	NumPaints = 0;
+	bFramesChanged = true;
+
+	Invalidate(EInvalidateWidgetReason::Layout);
+}
+
+void SLoadingFlipbook::SetStreamer(const TSharedPtr<FLoadingScreenImageStreamer, ESPMode::ThreadSafe>& InStreamer)
+{
+	Streamer = InStreamer;
+	bFramesChanged = true;
+
+	Invalidate(EInvalidateWidgetReason::Layout);
+}
+
+double SLoadingFlipbook::GetNextPaintTime(double CurrentTime) const
+{
+	if (bFramesChanged)
+	{
+		return CurrentTime;
+	}
+
+	if (Streamer.IsValid())
+	{
+		return Streamer->GetNumFrames() > 0 ? Streamer->GetNextFrameTime(CurrentTime) : MAX_dbl;
+	}
+
+	if (GetNumFrames() <= 1)
+	{
+		return MAX_dbl;
+	}
+
+	if (Interval <= 0.0f)
+	{
+		return CurrentTime;
+	}
+
+	// The next image is due at the next multiple of Interval since the start, however late the last paint was
+	return StartTime + (FMath::FloorToDouble((CurrentTime - StartTime) / Interval) + 1.0) * Interval;
+}
+
+int32 SLoadingFlipbook::GetNumFrames() const
+{
+	if (Streamer.IsValid())
+	{
+		return Streamer->GetNumFrames();
+	}
+
+	if (UVRegions.Num() > 0)
+	{
+		return Brushes.Num() > 0 ? UVRegions.Num() : 0;
+	}
+
+	return Brushes.Num();
+}
+
+int32 SLoadingFlipbook::GetFrameIndex(double CurrentTime) const
+{
+	const int32 NumFrames = GetNumFrames();
+	const int64 Step = Interval > 0.0f ? (int64)FMath::FloorToDouble((CurrentTime - StartTime) / Interval) : NumPaints;
+	const int32 FrameIndex = (int32)(FMath::Max<int64>(Step, 0) % NumFrames);
+
+	return bPlayReverse ? NumFrames - 1 - FrameIndex : FrameIndex;
+}
+
+int32 SLoadingFlipbook::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	bFramesChanged = false;
+
+	if (GetNumFrames() == 0)
+	{
+		return LayerId;
+	}
+
+	const ESlateDrawEffect DrawEffects = ShouldBeEnabled(bParentEnabled) ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect;
+
+	if (Streamer.IsValid())
+	{
+		FSlateBrush StreamedBrush;
+		if (Streamer->GetFrameBrush(FPlatformTime::Seconds(), StreamedBrush))
+		{
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), &StreamedBrush, DrawEffects, InWidgetStyle.GetColorAndOpacityTint() * StreamedBrush.GetTint(InWidgetStyle));
+		}
+		return LayerId;
+	}
+
+	const int32 FrameIndex = GetFrameIndex(FPlatformTime::Seconds());
+	++NumPaints;
+
+	// Moving the UV region keeps drawing the same texture, so every image of the atlas batches the same way
+	const FSlateBrush* FrameBrush = nullptr;
+	if (UVRegions.Num() > 0)
+	{
+		AtlasFrameBrush.SetUVRegion(UVRegions[FrameIndex]);
+		FrameBrush = &AtlasFrameBrush;
+	}
+	else if (Brushes[FrameIndex].IsValid())
+	{
+		FrameBrush = Brushes[FrameIndex]->GetSlateBrush();
+	}
+
+	if (FrameBrush)
+	{
+		FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), FrameBrush, DrawEffects, InWidgetStyle.GetColorAndOpacityTint() * FrameBrush->GetTint(InWidgetStyle));
+	}
+
+	return LayerId;
+}
+
+FVector2D SLoadingFlipbook::ComputeDesiredSize(float) const
+{
+	return Streamer.IsValid() ? Streamer->GetFrameSize() : FrameSize;
+}
+
+TSharedPtr<FDeferredCleanupSlateBrush> SLoadingFlipbook::PackAtlas(const TArray<UTexture2D*>& Images, TArray<FBox2D>& OutUVRegions)
+{
+	check(IsInGameThread());
+
+	OutUVRegions.Reset();
+
+	if (Images.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	// A texel of padding around each image keeps bilinear filtering from bleeding into the neighbouring images
+	const int32 Padding = 1;
+
+	FIntPoint CellSize(0, 0);
+	for (UTexture2D* Image : Images)
+	{
+		CellSize.X = FMath::Max(CellSize.X, FMath::CeilToInt(Image->GetSurfaceWidth()) + 2 * Padding);
+		CellSize.Y = FMath::Max(CellSize.Y, FMath::CeilToInt(Image->GetSurfaceHeight()) + 2 * Padding);
+	}
+
+	const int32 NumColumns = FMath::CeilToInt(FMath::Sqrt((float)Images.Num()));
+	const int32 NumRows = FMath::DivideAndRoundUp(Images.Num(), NumColumns);
+	const FIntPoint AtlasSize(NumColumns * CellSize.X, NumRows * CellSize.Y);
+
+	const int32 MaxTextureDimension = (int32)GetMax2DTextureDimension();
+	if (AtlasSize.X > MaxTextureDimension || AtlasSize.Y > MaxTextureDimension)
+	{
+		UE_LOG(LogMoviePlayer, Warning, TEXT("Loading screen image sequence needs a %dx%d atlas, more than the maximum texture size %d, drawing one brush per image instead"), AtlasSize.X, AtlasSize.Y, MaxTextureDimension);
+		return nullptr;
+	}
+
+	UTextureRenderTarget2D* AtlasTexture = NewObject<UTextureRenderTarget2D>(GetTransientPackage(), NAME_None, RF_Transient);
+	AtlasTexture->ClearColor = FLinearColor::Transparent;
+	AtlasTexture->InitCustomFormat(AtlasSize.X, AtlasSize.Y, PF_B8G8R8A8, false);
+	AtlasTexture->UpdateResourceImmediate(true);
+
+	FTextureRenderTargetResource* AtlasResource = AtlasTexture->GameThread_GetRenderTargetResource();
+	FCanvas Canvas(AtlasResource, nullptr, nullptr, GMaxRHIFeatureLevel);
+
+	const FVector2D AtlasUVScale(1.0f / AtlasSize.X, 1.0f / AtlasSize.Y);
+	for (int32 ImageIndex = 0; ImageIndex < Images.Num(); ++ImageIndex)
+	{
+		UTexture2D* Image = Images[ImageIndex];
+		const FVector2D ImageSize(Image->GetSurfaceWidth(), Image->GetSurfaceHeight());
+		const FVector2D Position((ImageIndex % NumColumns) * CellSize.X + Padding, (ImageIndex / NumColumns) * CellSize.Y + Padding);
+
+		// Draws whatever mips are resident now, streaming isn't waited on during loading screen setup
+		FCanvasTileItem TileItem(Position, Image->Resource, ImageSize, FLinearColor::White);
+		TileItem.BlendMode = SE_BLEND_Opaque;
+		Canvas.DrawItem(TileItem);
+
+		OutUVRegions.Add(FBox2D(Position * AtlasUVScale, (Position + ImageSize) * AtlasUVScale));
+	}
+
+	Canvas.Flush_GameThread(true);
+
+	ENQUEUE_RENDER_COMMAND(ResolveLoadingScreenAtlas)(
+		[AtlasResource](FRHICommandListImmediate& RHICmdList)
+		{
+			RHICmdList.CopyToResolveTarget(AtlasResource->GetRenderTargetTexture(), AtlasResource->TextureRHI, FResolveParams());
+		});
+
+	UE_LOG(LogMoviePlayer, Verbose, TEXT("Packed %d loading screen images into a %dx%d atlas"), Images.Num(), AtlasSize.X, AtlasSize.Y);
+
+	return FDeferredCleanupSlateBrush::CreateBrush(AtlasTexture, FVector2D(AtlasSize));
+}
+
+void SLoadingFlipbook::GetGridUVRegions(const FIntPoint& GridSize, int32 NumFrames, TArray<FBox2D>& OutUVRegions)
+{
+	OutUVRegions.Reset();
+
+	const FIntPoint Grid(FMath::Max(GridSize.X, 1), FMath::Max(GridSize.Y, 1));
+	const int32 NumCells = Grid.X * Grid.Y;
+	const int32 NumUsedCells = NumFrames > 0 ? FMath::Min(NumFrames, NumCells) : NumCells;
+	const FVector2D CellUVSize(1.0f / Grid.X, 1.0f / Grid.Y);
+
+	for (int32 CellIndex = 0; CellIndex < NumUsedCells; ++CellIndex)
+	{
+		const FVector2D CellUVMin((CellIndex % Grid.X) * CellUVSize.X, (CellIndex / Grid.X) * CellUVSize.Y);
+		OutUVRegions.Add(FBox2D(CellUVMin, CellUVMin + CellUVSize));
+	}
+}
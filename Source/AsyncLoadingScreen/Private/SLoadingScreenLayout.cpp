@@ -8,6 +8,16 @@
 
 #include "SLoadingScreenLayout.h"
 #include "Engine/UserInterfaceSettings.h"
+#include "Slate/SInvalidationPanel.h"
+#include "HAL/IConsoleManager.h"
+#include "LoadingScreenSettings.h"
+
+static TAutoConsoleVariable<int32> CVarAsyncLoadingScreenCacheStaticLayers(
+	TEXT("AsyncLoadingScreen.CacheStaticLayers"),
+	-1,
+	TEXT("Cache the static layers of the built-in loading screen layouts, only the animated widgets are repainted every frame. Applies to the loading screens set up afterwards.\n")
+	TEXT("< 0: use Performance.bCacheStaticLayers from the project settings (default), 0: repaint everything, 1: cache"),
+	ECVF_Default);
 
 float SLoadingScreenLayout::PointSizeToSlateUnits(float PointSize)
 {
@@ -17,6 +27,23 @@ float SLoadingScreenLayout::PointSizeToSlateUnits(float PointSize)
 	return PixelSize;
 }
 
+TSharedRef<SWidget> SLoadingScreenLayout::MakeCachedLayout(const TSharedRef<SWidget>& Layout)
+{
+	const int32 CacheStaticLayersOverride = CVarAsyncLoadingScreenCacheStaticLayers.GetValueOnGameThread();
+	const bool bCacheStaticLayers = CacheStaticLayersOverride >= 0 ? CacheStaticLayersOverride != 0 : GetDefault<ULoadingScreenSettings>()->Performance.bCacheStaticLayers;
+
+	if (!bCacheStaticLayers)
+	{
+		return Layout;
+	}
+
+	return SNew(SInvalidationPanel)
+		.DebugName(TEXT("LoadingScreenLayout"))
+		[
+			Layout
+		];
+}
+
 float SLoadingScreenLayout::GetDPIScale() const
 {
 	const FVector2D& DrawSize = GetTickSpaceGeometry().ToPaintGeometry().GetLocalSize();
@@ -11,42 +11,63 @@
 #include "Slate/DeferredCleanupSlateBrush.h"
 #include "Widgets/Layout/SSpacer.h"
 #include "Engine/Texture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
 #include "MoviePlayer.h"
 #include "Widgets/SCompoundWidget.h"
 #include "SExtendedThrobber.h"
+#include "LoadingScreenRedrawMetaData.h"
+#include "SLoadingFlipbook.h"
+#include "LoadingScreenImageStreamer.h"
+#include "LoadingScreenAssetCache.h"
+#include "CustomMoviePlayer.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectGlobals.h"
+#include "Engine/Engine.h"
 
-int32 SLoadingWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
-{		
-	TotalDeltaTime += Args.GetDeltaTime();
+void SLoadingWidget::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
 
-	if (TotalDeltaTime >= Interval)
+	if (PendingImages.IsValid())
 	{
-		if (CleanupBrushList.Num() > 1)
+		bool bArrived = false;
+		FImageSequence ImageSequence;
 		{
-			if (bPlayReverse)
-			{
-				ImageIndex--;
-			}
-			else
-			{
-				ImageIndex++;
-			}
-
-			if (ImageIndex >= CleanupBrushList.Num())
+			FScopeLock PendingImagesLock(&PendingImages->CriticalSection);
+			if (PendingImages->bArrived)
 			{
-				ImageIndex = 0;
-			}
-			else if (ImageIndex < 0)
-			{
-				ImageIndex = CleanupBrushList.Num() - 1;
+				bArrived = true;
+				ImageSequence = MoveTemp(PendingImages->ImageSequence);
 			}
+		}
 
-			StaticCastSharedRef<SImage>(LoadingIcon)->SetImage(CleanupBrushList[ImageIndex].IsValid() ? CleanupBrushList[ImageIndex]->GetSlateBrush() : nullptr);			
+		// The widget may hold the last reference, release it only once its lock is released
+		if (bArrived)
+		{
+			SetImageSequence(MoveTemp(ImageSequence));
+			PendingImages.Reset();
 		}
+	}
+}
 
-		TotalDeltaTime = 0.0f;
+int32 SLoadingWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{		
+	if (CleanupBrushList.Num() > 1)
+	{
+		// The image is picked from the time since the sequence started, so a late paint doesn't slow the animation down
+		const int32 NumImages = CleanupBrushList.Num();
+		const int64 Step = Interval > 0.0f ? (int64)FMath::FloorToDouble((FPlatformTime::Seconds() - StartTime) / Interval) : NumPaints;
+		const int32 StepIndex = (int32)(FMath::Max<int64>(Step, 0) % NumImages);
+		const int32 NewImageIndex = bPlayReverse ? (NumImages - StepIndex) % NumImages : StepIndex;
+		++NumPaints;
+
+		if (NewImageIndex != ImageIndex)
+		{
+			ImageIndex = NewImageIndex;
+			StaticCastSharedRef<SImage>(LoadingIcon)->SetImage(CleanupBrushList[ImageIndex].IsValid() ? CleanupBrushList[ImageIndex]->GetSlateBrush() : nullptr);
+		}
 	}
-	
+
 
 	return SCompoundWidget::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
 }
@@ -62,30 +83,72 @@ SThrobber::EAnimation SLoadingWidget::GetThrobberAnimation(FThrobberSettings Thr
 
 void SLoadingWidget::ConstructLoadingIcon(const FLoadingWidgetSettings& Settings)
 {
+	bIsImageSequence = Settings.LoadingIconType == ELoadingIconType::LIT_ImageSequence;
+
+	// The icon animates every frame or so, keep it out of the cached layers of the layout
+	ForceVolatile(true);
+
+	// Let the custom loading screen thread know when the icon animates
+	AddMetadata(MakeShared<FLoadingScreenRedrawMetaData>(FLoadingScreenRedrawMetaData::FGetNextPaintTime::CreateSP(this, &SLoadingWidget::GetNextPaintTime)));
+
 	if (Settings.LoadingIconType == ELoadingIconType::LIT_ImageSequence)
 	{
 		// Loading Widget is image sequence
-		if (Settings.ImageSequenceSettings.Images.Num() > 0)
+		TArray<TSoftObjectPtr<UTexture2D>> ImageAssets;
+		GetImageSequenceAssets(Settings.ImageSequenceSettings, ImageAssets);
+
+		if (Settings.ImageSequenceSettings.bStreamImages && Settings.ImageSequenceSettings.Images.Num() > 0 && GEngine && GEngine->IsInitialized())
+		{
+			// Streamed images are loaded while playing, nothing is loaded up front
+			Interval = Settings.ImageSequenceSettings.Interval;
+
+			TSharedRef<FLoadingScreenImageStreamer, ESPMode::ThreadSafe> Streamer = MakeShared<FLoadingScreenImageStreamer, ESPMode::ThreadSafe>(Settings.ImageSequenceSettings);
+			Streamer->Start();
+
+			LoadingIcon = SAssignNew(LoadingFlipbook, SLoadingFlipbook)
+				.Interval(Interval)
+				.bPlayReverse(bPlayReverse);
+			LoadingFlipbook->SetStreamer(Streamer);
+		}
+		else if (ImageAssets.Num() > 0)
 		{
 			CleanupBrushList.Empty();
 			ImageIndex = 0;
 
-			FVector2D Scale = Settings.ImageSequenceSettings.Scale;
+			// Update play animation interval
+			Interval = Settings.ImageSequenceSettings.Interval;
 
-			for (auto Image: Settings.ImageSequenceSettings.Images)
+			// Create Image slate widget, it stays empty until the images are streamed in
+			if (Settings.ImageSequenceSettings.bUseAtlas)
 			{
-				if (Image)
-				{
-					CleanupBrushList.Add(FDeferredCleanupSlateBrush::CreateBrush(Image, FVector2D(Image->GetSurfaceWidth() * Scale.X, Image->GetSurfaceHeight() * Scale.Y)));					
-				}				
+				LoadingIcon = SAssignNew(LoadingFlipbook, SLoadingFlipbook)
+					.Interval(Interval)
+					.bPlayReverse(bPlayReverse);
+			}
+			else
+			{
+				LoadingIcon = SNew(SImage);
 			}
-		
-			// Create Image slate widget
-			LoadingIcon = SNew(SImage)
-				.Image(CleanupBrushList[ImageIndex]->GetSlateBrush());
 
-			// Update play animation interval
-			Interval = Settings.ImageSequenceSettings.Interval;
+			// Async loading is only ticked once the engine is up, the startup loading screen has to load synchronously
+			bool bAllImagesLoaded = true;
+			for (const TSoftObjectPtr<UTexture2D>& Image : ImageAssets)
+			{
+				bAllImagesLoaded &= Image.IsNull() || Image.IsValid();
+			}
+
+			if (bAllImagesLoaded || !(GEngine && GEngine->IsInitialized()))
+			{
+				for (const TSoftObjectPtr<UTexture2D>& Image : ImageAssets)
+				{
+					Image.LoadSynchronous();
+				}
+				SetImageSequence(CreateImageSequence(Settings.ImageSequenceSettings, FLoadingScreenAssetCache::Get().GetCurrentScreenName()));
+			}
+			else
+			{
+				RequestImageSequenceAsync(Settings.ImageSequenceSettings);
+			}
 		}
 		else
 		{
@@ -132,6 +195,223 @@ void SLoadingWidget::ConstructLoadingIcon(const FLoadingWidgetSettings& Settings
 	}	
 }
 
+double SLoadingWidget::GetNextPaintTime(double CurrentTime) const
+{
+	const bool bIsVisible = GetVisibility().IsVisible();
+	if (bIsVisible != bWasVisible)
+	{
+		bWasVisible = bIsVisible;
+		return CurrentTime;
+	}
+
+	if (!bIsVisible)
+	{
+		return MAX_dbl;
+	}
+
+	if (PendingImages.IsValid())
+	{
+		// Nothing to animate until the images are streamed in
+		FScopeLock PendingImagesLock(&PendingImages->CriticalSection);
+		return PendingImages->bArrived ? CurrentTime : MAX_dbl;
+	}
+
+	if (bIsImageSequence)
+	{
+		// A single image never changes, otherwise the next image is due at the next multiple of Interval since the start
+		if (CleanupBrushList.Num() <= 1)
+		{
+			return MAX_dbl;
+		}
+
+		return Interval > 0.0f ? StartTime + (FMath::FloorToDouble((CurrentTime - StartTime) / Interval) + 1.0) * Interval : CurrentTime;
+	}
+
+	// Throbbers animate continuously
+	return CurrentTime;
+}
+
+void SLoadingWidget::GetImageSequenceAssets(const FImageSequenceSettings& ImageSequenceSettings, TArray<TSoftObjectPtr<UTexture2D>>& OutAssets)
+{
+	if (ImageSequenceSettings.bUseAtlas && !ImageSequenceSettings.Atlas.IsNull())
+	{
+		OutAssets.Add(ImageSequenceSettings.Atlas);
+	}
+	else
+	{
+		OutAssets.Append(ImageSequenceSettings.Images);
+	}
+}
+
+SLoadingWidget::FImageSequence SLoadingWidget::CreateImageSequence(const FImageSequenceSettings& ImageSequenceSettings, const FName& CachedScreenName)
+{
+	FImageSequence ImageSequence;
+
+	const FVector2D Scale = ImageSequenceSettings.Scale;
+	int64 TextureMemorySize = 0;
+
+	TArray<UTexture2D*> Images;
+	TArray<FSoftObjectPath> ImagePaths;
+	for (const TSoftObjectPtr<UTexture2D>& ImagePtr : ImageSequenceSettings.Images)
+	{
+		if (UTexture2D* Image = ImagePtr.Get())
+		{
+			Images.Add(Image);
+			ImagePaths.Add(ImagePtr.ToSoftObjectPath());
+		}
+	}
+
+	if (ImageSequenceSettings.bUseAtlas)
+	{
+		if (UTexture2D* Atlas = ImageSequenceSettings.Atlas.Get())
+		{
+			const FIntPoint GridSize(FMath::Max(ImageSequenceSettings.AtlasGridSize.X, 1), FMath::Max(ImageSequenceSettings.AtlasGridSize.Y, 1));
+			SLoadingFlipbook::GetGridUVRegions(GridSize, ImageSequenceSettings.AtlasFrameCount, ImageSequence.UVRegions);
+			ImageSequence.Brushes.Add(FDeferredCleanupSlateBrush::CreateBrush(Atlas, FVector2D(Atlas->GetSurfaceWidth(), Atlas->GetSurfaceHeight())));
+			ImageSequence.FrameSize = FVector2D(Atlas->GetSurfaceWidth() / GridSize.X * Scale.X, Atlas->GetSurfaceHeight() / GridSize.Y * Scale.Y);
+			TextureMemorySize += Atlas->CalcTextureMemorySizeEnum(TMC_ResidentMips);
+			FLoadingScreenAssetCache::Get().Pin(CachedScreenName, Atlas);
+		}
+		else if (Images.Num() > 0 && GEngine && GEngine->IsInitialized())
+		{
+			// The images are released once packed, only the atlas stays resident, and is reused for as long as its loading screen is cached
+			UTextureRenderTarget2D* AtlasTexture = FLoadingScreenAssetCache::Get().FindAtlas(ImagePaths, ImageSequence.UVRegions);
+			if (!AtlasTexture)
+			{
+				// Streamed images may only have their smallest mips resident right after loading, packing those would bake a blurry atlas
+				bool bFullyResident = true;
+				for (UTexture2D* Image : Images)
+				{
+					if (Image->IsStreamable() && Image->GetNumResidentMips() < Image->GetNumMips())
+					{
+						// The per image brushes below keep showing the images, the atlas is packed the next time this loading screen shows
+						Image->StreamIn(Image->GetNumMips(), true);
+						bFullyResident = false;
+					}
+				}
+
+				if (bFullyResident)
+				{
+					TSharedPtr<FDeferredCleanupSlateBrush> AtlasBrush = SLoadingFlipbook::PackAtlas(Images, ImageSequence.UVRegions);
+					AtlasTexture = AtlasBrush.IsValid() ? Cast<UTextureRenderTarget2D>(AtlasBrush->GetSlateBrush()->GetResourceObject()) : nullptr;
+				}
+				else
+				{
+					UE_LOG(LogMoviePlayer, Verbose, TEXT("Loading screen images aren't fully streamed in yet, drawing one brush per image until the atlas can be packed"));
+				}
+			}
+
+			if (AtlasTexture)
+			{
+				// Kept along with this loading screen, also when it was found for another one packed from the same images
+				FLoadingScreenAssetCache::Get().AddAtlas(CachedScreenName, ImagePaths, AtlasTexture, ImageSequence.UVRegions);
+
+				ImageSequence.Brushes.Add(FDeferredCleanupSlateBrush::CreateBrush(AtlasTexture, FVector2D(AtlasTexture->SizeX, AtlasTexture->SizeY)));
+				ImageSequence.FrameSize = FVector2D(Images[0]->GetSurfaceWidth() * Scale.X, Images[0]->GetSurfaceHeight() * Scale.Y);
+				TextureMemorySize += AtlasTexture->CalcTextureMemorySizeEnum(TMC_ResidentMips);
+			}
+			else
+			{
+				ImageSequence.UVRegions.Reset();
+			}
+		}
+	}
+
+	// Without atlas, or when the images couldn't be packed, each image gets its own brush
+	if (ImageSequence.Brushes.Num() == 0)
+	{
+		for (UTexture2D* Image : Images)
+		{
+			ImageSequence.Brushes.Add(FDeferredCleanupSlateBrush::CreateBrush(Image, FVector2D(Image->GetSurfaceWidth() * Scale.X, Image->GetSurfaceHeight() * Scale.Y)));
+			TextureMemorySize += Image->CalcTextureMemorySizeEnum(TMC_ResidentMips);
+			FLoadingScreenAssetCache::Get().Pin(CachedScreenName, Image);
+		}
+
+		if (Images.Num() > 0)
+		{
+			ImageSequence.FrameSize = FVector2D(Images[0]->GetSurfaceWidth() * Scale.X, Images[0]->GetSurfaceHeight() * Scale.Y);
+		}
+	}
+
+	UE_LOG(LogMoviePlayer, Verbose, TEXT("Loading screen image sequence holds %d brushes, %.1f KB of texture memory until it hides"), ImageSequence.Brushes.Num(), TextureMemorySize / 1024.0);
+
+	return ImageSequence;
+}
+
+void SLoadingWidget::SetImageSequence(FImageSequence&& ImageSequence)
+{
+	if (LoadingFlipbook.IsValid())
+	{
+		LoadingFlipbook->SetFrames(ImageSequence.Brushes, ImageSequence.UVRegions, ImageSequence.FrameSize);
+		return;
+	}
+
+	CleanupBrushList = MoveTemp(ImageSequence.Brushes);
+	ImageIndex = 0;
+	StartTime = FPlatformTime::Seconds();
+	NumPaints = 0;
+
+	StaticCastSharedRef<SImage>(LoadingIcon)->SetImage(CleanupBrushList.Num() > 0 && CleanupBrushList[ImageIndex].IsValid() ? CleanupBrushList[ImageIndex]->GetSlateBrush() : nullptr);
+}
+
+void SLoadingWidget::RequestImageSequenceAsync(const FImageSequenceSettings& ImageSequenceSettings)
+{
+	// Ahead of the level packages so the loading icon shows up as early as possible
+	const int32 ImagePackagePriority = 100;
+
+	TArray<TSoftObjectPtr<UTexture2D>> ImageAssets;
+	GetImageSequenceAssets(ImageSequenceSettings, ImageAssets);
+
+	TSet<FString> PackageNames;
+	for (const TSoftObjectPtr<UTexture2D>& Image : ImageAssets)
+	{
+		if (!Image.IsNull() && !Image.IsValid())
+		{
+			PackageNames.Add(Image.ToSoftObjectPath().GetLongPackageName());
+		}
+	}
+
+	PendingImages = MakeShared<FPendingImages, ESPMode::ThreadSafe>();
+	PendingImages->NumPendingPackages = PackageNames.Num();
+
+	TSharedRef<FPendingImages, ESPMode::ThreadSafe> InPendingImages = PendingImages.ToSharedRef();
+	const FImageSequenceSettings InImageSequenceSettings = ImageSequenceSettings;
+	const FName CachedScreenName = FLoadingScreenAssetCache::Get().GetCurrentScreenName();
+	for (const FString& PackageName : PackageNames)
+	{
+		LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateLambda(
+			[InPendingImages, InImageSequenceSettings, ImageAssets, CachedScreenName](const FName& LoadedPackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+			{
+				// Called on the game thread
+				if (Result != EAsyncLoadingResult::Succeeded)
+				{
+					UE_LOG(LogMoviePlayer, Warning, TEXT("Failed to load the loading icon image package %s, the image sequence plays without it"), *LoadedPackageName.ToString());
+				}
+
+				// A garbage collection (the map load runs one) may happen before the rest of the batch is in
+				for (const TSoftObjectPtr<UTexture2D>& ImagePtr : ImageAssets)
+				{
+					UTexture2D* Image = ImagePtr.Get();
+					if (Image && !InPendingImages->LoadedImages.ContainsByPredicate([Image](const TStrongObjectPtr<UTexture2D>& LoadedImage) { return LoadedImage.Get() == Image; }))
+					{
+						InPendingImages->LoadedImages.Add(TStrongObjectPtr<UTexture2D>(Image));
+					}
+				}
+
+				// Only the last package of the batch creates the brushes, which reference the images from then on
+				if (--InPendingImages->NumPendingPackages == 0)
+				{
+					FImageSequence ImageSequence = CreateImageSequence(InImageSequenceSettings, CachedScreenName);
+					InPendingImages->LoadedImages.Empty();
+
+					FScopeLock PendingImagesLock(&InPendingImages->CriticalSection);
+					InPendingImages->ImageSequence = MoveTemp(ImageSequence);
+					InPendingImages->bArrived = true;
+				}
+			}), ImagePackagePriority);
+	}
+}
+
 EVisibility SLoadingWidget::GetLoadingWidgetVisibility() const
 {
 	return GetMoviePlayer()->IsLoadingFinished() ? EVisibility::Hidden : EVisibility::Visible;
@@ -178,6 +178,6 @@ void SSidebarLayout::Construct(const FArguments& InArgs, const FALoadingScreenSe
 	// Add root to this widget
 	ChildSlot
 	[
-		Root
+		MakeCachedLayout(Root)
 	];
 }
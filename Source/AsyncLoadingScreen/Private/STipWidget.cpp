@@ -10,6 +10,7 @@
 #include "LoadingScreenSettings.h"
 #include "Widgets/Text/STextBlock.h"
 #include "AsyncLoadingScreenLibrary.h"
+#include "LoadingScreenTextPrewarm.h"
 
 void STipWidget::Construct(const FArguments& InArgs, const FTipSettings& Settings)
 {
@@ -25,6 +26,8 @@ void STipWidget::Construct(const FArguments& InArgs, const FTipSettings& Setting
 			}
 		}
 
+		FLoadingScreenTextPrewarm::Prewarm(Settings.TipText[TipIndex], Settings.Appearance.Font);
+
 		ChildSlot
 		[
 			SNew(STextBlock)		
@@ -32,6 +32,11 @@ private:
 	*/
 	static void SetupLoadingScreenInternal(IGameMoviePlayer* movie_player, const FALoadingScreenSettings& loading_settings);
 
+	/**
+	* Find the name of loading screen settings, the reverse of GetLoadingScreenSettingsByName. Returns false for settings that aren't part of ULoadingScreenSettings
+	*/
+	static bool FindLoadingScreenSettingsName(const FALoadingScreenSettings& loading_settings, FName& out_settings_name);
+
 public:
 	
 	/**
@@ -59,7 +64,7 @@ public:
 	static void SetDisplayMovieIndex(int32 MovieIndex);
 
 	/**
-	* Get loading screen settings by name. Empty name is the ULoadingScreenSettings::StartupLoadingScreen. '__default' is the ULoadingScreenSettings::DefaultLoadingScreen
+	* Get loading screen settings by name. Empty name or '__startup' is the ULoadingScreenSettings::StartupLoadingScreen. '__default' is the ULoadingScreenSettings::DefaultLoadingScreen
 	*/
 	static const FALoadingScreenSettings* GetLoadingScreenSettingsByName(const FName& settings_name);
 
@@ -71,6 +76,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Async Loading Screen")
 	static void StartCustomLoadingScreen(FName custom_settings_name);
 
+	/**
+	 * Start loading the assets of a loading screen ahead of it, e.g. when initiating the travel, so it shows up complete right away.
+	 * Only the custom widget class of the Custom Widget layout is preloaded, it stays loaded until the loading screen uses it.
+	 *
+	 * @param CustomSettingsName Name of settings in the map CustomLoadingScreens, '__default' for the DefaultLoadingScreen.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "Async Loading Screen")
+	static void PreloadLoadingScreen(FName custom_settings_name);
+
 	/**
 	* Setup loading screen settings 
 	*/
@@ -91,6 +105,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Async Loading Screen")
 	static void StopCustomLoadingScreen();
 
+	/**
+	 * Get the time in seconds from the setup of the last custom loading screen (StartCustomLoadingScreen) to its first frame on screen.
+	 * Returns -1 if no custom loading screen has presented a frame yet.
+	 **/
+	UFUNCTION(BlueprintPure, Category = "Async Loading Screen")
+	static float GetTimeToFirstFrame();
+
 	/**
 	* Shuffle the movies list
 	*/
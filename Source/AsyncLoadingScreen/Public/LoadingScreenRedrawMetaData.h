@@ -0,0 +1,38 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "Types/ISlateMetaData.h"
+
+/**
+ * Tells the custom loading screen thread when a widget has to be repainted, so it can skip the frames where nothing changed.
+ * Animated widgets carry one whose delegate returns their next animation deadline.
+ * The root widget of a layout carries one without delegate to mark that all of its animated widgets are tagged,
+ * loading screens without it (e.g. custom UMG widgets) are always repainted.
+ */
+class FLoadingScreenRedrawMetaData : public ISlateMetaData
+{
+public:
+	SLATE_METADATA_TYPE(FLoadingScreenRedrawMetaData, ISlateMetaData)
+
+	/** Returns the next time in seconds (FPlatformTime::Seconds) the widget has to be repainted at, CurrentTime to be repainted every frame or MAX_dbl when idle */
+	DECLARE_DELEGATE_RetVal_OneParam(double, FGetNextPaintTime, double /*CurrentTime*/);
+
+	FLoadingScreenRedrawMetaData()
+	{
+	}
+
+	FLoadingScreenRedrawMetaData(const FGetNextPaintTime& InGetNextPaintTime)
+		: GetNextPaintTime(InGetNextPaintTime)
+	{
+	}
+
+	/** Called on the loading screen thread, unbound on the layout root */
+	FGetNextPaintTime GetNextPaintTime;
+};
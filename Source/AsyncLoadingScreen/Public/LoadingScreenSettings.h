@@ -85,6 +85,31 @@ enum class ELoadingWidgetType : uint8
 	LWT_Vertical UMETA(DisplayName = "Vertical"),
 };
 
+/** Scheduling priority of the loading screen thread, mirrors EThreadPriority */
+UENUM(BlueprintType)
+enum class ELoadingScreenThreadPriority : uint8
+{
+	LSTP_Normal UMETA(DisplayName = "Normal"),
+	LSTP_AboveNormal UMETA(DisplayName = "Above Normal"),
+	LSTP_BelowNormal UMETA(DisplayName = "Below Normal"),
+	LSTP_SlightlyBelowNormal UMETA(DisplayName = "Slightly Below Normal"),
+	LSTP_Lowest UMETA(DisplayName = "Lowest"),
+	LSTP_Highest UMETA(DisplayName = "Highest"),
+	LSTP_TimeCritical UMETA(DisplayName = "Time Critical"),
+};
+
+/** How often the custom loading screen flushes the RHI thread resources */
+UENUM(BlueprintType)
+enum class ELoadingScreenRHIFlushPolicy : uint8
+{
+	/** Flush the RHI thread and its pending resource deletions after every frame */
+	LSFP_EveryFrame UMETA(DisplayName = "Every Frame"),
+	/** Flush resources every RHIFlushInterval frames, the other frames are only dispatched to the RHI thread */
+	LSFP_Periodic UMETA(DisplayName = "Periodic"),
+	/** Flush resources on the first frame of the loading screen only, the other frames are only dispatched to the RHI thread */
+	LSFP_OnScreenChange UMETA(DisplayName = "On Screen Change"),
+};
+
 /** Alignment for widget*/
 USTRUCT(BlueprintType)
 struct FWidgetAlignment
@@ -179,9 +204,12 @@ struct FImageSequenceSettings
 {
 	GENERATED_BODY()
 
-	/** An array of images for animating the loading icon.*/
+	/**
+	 * An array of images for animating the loading icon.
+	 * They are only loaded, in one asynchronous batch, when the loading screen using them is shown and released once it hides.
+	 */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting", meta = (AllowedClasses = "Texture2D"))
-	TArray<UTexture2D*> Images;
+	TArray<TSoftObjectPtr<UTexture2D>> Images;
 
 	/** Scale of the images.*/
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting")
@@ -196,6 +224,38 @@ struct FImageSequenceSettings
 	/** Play the image sequence in reverse.*/
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting")
 	bool bPlayReverse = false;
+
+	/**
+	 * Draw the image sequence from a single texture atlas, one brush with a UV region per image instead of one brush per image.
+	 * The images are packed into an atlas when the loading screen is shown unless a pre-packed Atlas is set.
+	 * Images are picked by elapsed time rather than per paint, so the animation keeps its speed when frames are skipped.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting")
+	bool bUseAtlas = false;
+
+	/** Optional pre-packed atlas of the image sequence, laid out as a grid of equally sized images from left to right and top to bottom. Images is ignored when set. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting", meta = (AllowedClasses = "Texture2D", EditCondition = "bUseAtlas"))
+	TSoftObjectPtr<UTexture2D> Atlas;
+
+	/** Number of columns and rows of the pre-packed atlas.*/
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting", meta = (ClampMin = "1", EditCondition = "bUseAtlas"))
+	FIntPoint AtlasGridSize = FIntPoint(1, 1);
+
+	/** Number of images in the pre-packed atlas, 0 to use every cell of the grid.*/
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting", meta = (ClampMin = "0", EditCondition = "bUseAtlas"))
+	int32 AtlasFrameCount = 0;
+
+	/**
+	 * Only keep a window of upcoming images loaded while playing, for long or high resolution sequences.
+	 * Images ahead of the playhead are loaded asynchronously and the ones behind it are released, their memory is reclaimed by the next garbage collection.
+	 * An image that isn't loaded on time is dropped and the previous one stays on screen. Takes precedence over bUseAtlas.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting")
+	bool bStreamImages = false;
+
+	/** Number of upcoming images kept loaded when streaming.*/
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting", meta = (ClampMin = "1", UIMax = "32", EditCondition = "bStreamImages"))
+	int32 StreamingWindowSize = 8;
 };
 
 /**
@@ -228,6 +288,17 @@ struct ASYNCLOADINGSCREEN_API FBackgroundSettings
 	 */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Background")
 	bool bSetDisplayBackgroundManually = false;
+
+	/**
+	 * Stream the background image in asynchronously at high priority instead of loading it before the loading screen shows up.
+	 * The background color is displayed until the image arrives. The startup loading screen always loads synchronously as the engine isn't ticking async loading yet.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Background")
+	bool bLoadAsynchronously = true;
+
+	/** Time in seconds the background image takes to fade in once it has been streamed in */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Background", meta = (ClampMin = "0.0", UIMax = "2.0", EditCondition = "bLoadAsynchronously"))
+	float FadeInTime = 0.25f;
 };
 
 /**
@@ -479,6 +550,29 @@ struct ASYNCLOADINGSCREEN_API FALoadingScreenSettings
 	*/
 	UPROPERTY(Config, EditAnywhere, Category = "Loading Screen Settings", meta = (ToolTip = "Custom widget layout. Parameter Background.ImageStretch is used. ONLY using in non-StartupLoadingScreen", EditCondition = "Layout == ALSL_CustomWidget"))
 	TSoftClassPtr<UUserWidget> CustomLoadingWidget;
+
+	/**
+	 * Load the custom widget class asynchronously instead of blocking the start of the loading screen.
+	 * CustomWidgetFallbackLayout is shown until the class is loaded, call PreloadLoadingScreen when starting the travel to load it ahead.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Screen Settings", meta = (EditCondition = "Layout == ALSL_CustomWidget"))
+	bool bLoadCustomWidgetAsynchronously = true;
+
+	/** Built-in layout shown until the custom widget class is loaded. Custom Widget isn't a valid choice and falls back to Classic. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Screen Settings", meta = (EditCondition = "Layout == ALSL_CustomWidget && bLoadCustomWidgetAsynchronously"))
+	EAsyncLoadingScreenLayout CustomWidgetFallbackLayout = EAsyncLoadingScreenLayout::ALSL_Classic;
+
+	/**
+	 * How often the custom loading screen (StartCustomLoadingScreen) flushes the RHI thread resources.
+	 * Flushing every frame stalls the RHI thread resource deletion queue, a throbber frame rarely frees anything.
+	 * Every Frame is the engine behaviour, compare the RHIFlush stat of the AsyncLoadingScreen stat group before switching.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Performance")
+	ELoadingScreenRHIFlushPolicy RHIFlushPolicy = ELoadingScreenRHIFlushPolicy::LSFP_EveryFrame;
+
+	/** Number of frames between two resource flushes with the Periodic flush policy */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Performance", meta = (ClampMin = "1", UIMax = "120", EditCondition = "RHIFlushPolicy == ELoadingScreenRHIFlushPolicy::LSFP_Periodic"))
+	int32 RHIFlushInterval = 30;
 };
 
 /** Classic Layout settings*/
@@ -680,6 +774,142 @@ struct FDualSidebarLayoutSettings
 	FSlateBrush RightBorderBackground;
 };
 
+/**
+ * Performance settings of the custom loading screen (StartCustomLoadingScreen) thread
+ */
+USTRUCT(BlueprintType)
+struct FLoadingScreenPerformanceSettings
+{
+	GENERATED_BODY()
+
+	/**
+	 * Frame rate the loading screen thread paints at. Match it to the display refresh rate (e.g. 120 or 144) to avoid stutter on high refresh rate panels.
+	 * Can be overridden at runtime with the "AsyncLoadingScreen.TargetFrameRate" console variable.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "1", UIMin = "15", UIMax = "240"))
+	float TargetFrameRate = 60.0f;
+
+	/**
+	 * Number of draw passes the loading screen thread may paint ahead while the render thread is still submitting the previous ones.
+	 * 1 strictly alternates painting and rendering, higher values overlap them at the cost of up to that many frames of latency.
+	 * Can be overridden at runtime with the "AsyncLoadingScreen.DrawPassPipelineDepth" console variable.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "1", ClampMax = "3", UIMin = "1", UIMax = "3"))
+	int32 DrawPassPipelineDepth = 2;
+
+	/**
+	 * Time in seconds the game thread waits for the loading screen thread to stop before logging a warning. It keeps waiting afterwards, this only reports the overrun.
+	 * Can be overridden at runtime with the "AsyncLoadingScreen.ThreadShutdownTimeout" console variable.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "0.01", UIMin = "0.1", UIMax = "10.0"))
+	float ThreadShutdownTimeout = 1.0f;
+
+	/**
+	 * Scheduling priority of the loading screen thread. Lower it to leave more CPU time to the async loading thread on low core count machines.
+	 * Can be overridden at runtime with the "AsyncLoadingScreen.ThreadPriority" console variable.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	ELoadingScreenThreadPriority ThreadPriority = ELoadingScreenThreadPriority::LSTP_Normal;
+
+	/**
+	 * Mask of the cores the loading screen thread may run on, 0 lets it run on any core.
+	 * Can be overridden at runtime with the "AsyncLoadingScreen.ThreadAffinityMask" console variable, which also accepts hexadecimal values (e.g. 0x8).
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "0"))
+	int64 ThreadAffinityMask = 0;
+
+	/**
+	 * Stack size of the loading screen thread in KB, 0 uses the platform default.
+	 * Only applied when the thread is created, which happens on the first loading screen.
+	 * Can be overridden at runtime with the "AsyncLoadingScreen.ThreadStackSizeKB" console variable.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "0", UIMax = "1024"))
+	int32 ThreadStackSizeKB = 0;
+
+	/**
+	 * Skip painting frames where nothing on the loading screen changed, the loading screen thread sleeps until the next animation is due instead.
+	 * Only applies to the built-in layouts without movie, custom widgets are always repainted.
+	 * Can be overridden at runtime with the "AsyncLoadingScreen.SkipUnchangedFrames" console variable.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bSkipUnchangedFrames = true;
+
+	/**
+	 * Time in seconds after which an unchanged loading screen is repainted anyway, so that state the widgets don't report (e.g. bound attributes) is never stale for long.
+	 * Can be overridden at runtime with the "AsyncLoadingScreen.RedrawKeepAliveInterval" console variable.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "0.0", UIMax = "5.0", EditCondition = "bSkipUnchangedFrames"))
+	float RedrawKeepAliveInterval = 0.5f;
+
+	/**
+	 * Frame rate the loading screen thread drops to while the game window is minimized or unfocused, 0 pauses painting entirely.
+	 * The full rate resumes as soon as the window is restored or focused again.
+	 * Can be overridden at runtime with the "AsyncLoadingScreen.BackgroundFrameRate" console variable.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "0.0", UIMax = "60.0", EditCondition = "bThrottleInBackground"))
+	float BackgroundFrameRate = 5.0f;
+
+	/** Throttle the loading screen thread while the game window is minimized or unfocused */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bThrottleInBackground = true;
+
+	/**
+	 * Cache the static layers (background, tip, borders) of the built-in layouts in an invalidation panel, only the loading widget and loading complete text are repainted every frame.
+	 * Can be overridden at runtime with the "AsyncLoadingScreen.CacheStaticLayers" console variable.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bCacheStaticLayers = true;
+
+	/**
+	 * Number of frames the game thread may run ahead of the render thread while it waits for a loading screen to finish (minimum display time, manual stop, movies).
+	 * 0 fully serializes both threads every frame, higher values let them overlap.
+	 * Can be overridden at runtime with the "AsyncLoadingScreen.MaxGameThreadFramesAhead" console variable.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "0", ClampMax = "2", UIMin = "0", UIMax = "2"))
+	int32 MaxGameThreadFramesAhead = 1;
+
+	/**
+	 * Keep the assets of the loading screens (background images, loading icon images, custom widget class) loaded between level transitions,
+	 * so showing the same loading screen again doesn't load them again. Loading screens are evicted least recently used first once AssetCacheBudgetMB is exceeded.
+	 * Can be overridden at runtime with the "AsyncLoadingScreen.AssetCacheBudgetMB" console variable.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bCacheAssets = false;
+
+	/**
+	 * Memory budget in MB of the cached loading screen assets.
+	 * A loading screen whose assets alone exceed it isn't cached, its assets are released once it's gone like without the cache.
+	 * Assets shared by several loading screens count once.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bCacheAssets"))
+	int32 AssetCacheBudgetMB = 64;
+
+	/**
+	 * Shape the tip, loading and loading complete texts and rasterize their glyphs while the loading screen is set up on the game thread,
+	 * instead of on the first paint of the loading thread.
+	 * Can be overridden at runtime with the "AsyncLoadingScreen.PrewarmTextGlyphs" console variable.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bPrewarmTextGlyphs = true;
+
+	/**
+	 * Paint and present the first frame of the custom loading screen on the game thread when it starts, before handing over to the loading thread,
+	 * so it's on screen as soon as StartCustomLoadingScreen returns. Costs the game thread one render thread flush.
+	 * Can be overridden at runtime with the "AsyncLoadingScreen.PresentFirstFrameOnGameThread" console variable.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bPresentFirstFrameOnGameThread = false;
+
+	/**
+	 * Append the timings of every loading screen (time to first frame, load time, extra display time, loading thread frame time) and the map it covered
+	 * to Saved/AsyncLoadingScreen/LoadHistory.csv. The "AsyncLoadingScreen.LoadHistory" console command prints their percentiles per map.
+	 * The startup and default loading screens played by the engine movie player only record their load and extra display times.
+	 * Can be overridden at runtime with the "AsyncLoadingScreen.RecordLoadHistory" console variable.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bRecordLoadHistory = false;
+};
+
 /**
  * Async Loading Screen Settings 
  */
@@ -750,4 +980,9 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "Layout")
 	FDualSidebarLayoutSettings DualSidebar;
 
+	/**
+	 * Performance settings of the custom loading screen thread.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	FLoadingScreenPerformanceSettings Performance;
 };
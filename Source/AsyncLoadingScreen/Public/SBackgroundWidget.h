@@ -9,9 +9,11 @@
 #pragma once
 
 #include "Widgets/SCompoundWidget.h"
+#include "Widgets/Layout/SScaleBox.h"
 
 struct FBackgroundSettings;
 class FDeferredCleanupSlateBrush;
+class UTexture2D;
 
 /**
  * Background widget
@@ -25,6 +27,72 @@ public:
 
 	void Construct(const FArguments& InArgs, const FBackgroundSettings& Settings);
 
+	virtual ~SBackgroundWidget();
+
+	// SWidget overrides
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
+	/** Next time the background has to be repainted at, see FLoadingScreenRedrawMetaData */
+	double GetNextPaintTime(double CurrentTime) const;
+
 private:
+	/** Hands the asynchronously loaded image over from the game thread to the thread painting the loading screen */
+	struct FPendingImage
+	{
+		FCriticalSection CriticalSection;
+		TSharedPtr<FDeferredCleanupSlateBrush> Brush;
+		bool bArrived = false;
+
+		// Texture of the brush and the number of mips it needs resident to look sharp, the image is shown once they are
+		UTexture2D* Texture = nullptr;
+		int32 WantedMips = 0;
+
+		// The top mips of the texture are limited to WantedMips for this background, see AcquireMipLimit
+		bool bMipLimited = false;
+
+		// The widget is gone, a texture arriving after it is left alone
+		bool bWidgetDestroyed = false;
+
+		// Time the image was requested at
+		double RequestTime = 0.0;
+	};
+
+	/** Loads the package of the image at high priority, the brush is picked up in Tick once it's loaded */
+	void RequestImageAsync(const FSoftObjectPath& ImageAsset, EStretch::Type ImageStretch);
+
+	/**
+	 * Streams in the mips needed to draw the texture at the game viewport size with ImageStretch and streams out the top mips above them, on the game thread.
+	 * Returns the number of mips wanted, 0 when the texture can't be sized against the viewport.
+	 */
+	static int32 RequestMipResidency(UTexture2D* Texture, EStretch::Type ImageStretch);
+
+	/**
+	 * Keeps the texture streamer from streaming the top mips above WantedMips back in while a background shows the texture, on the game thread.
+	 * Returns true if the texture was limited, it has to be released with ReleaseMipLimit.
+	 */
+	static bool AcquireMipLimit(UTexture2D* Texture, int32 WantedMips);
+
+	/** Lifts the limit of AcquireMipLimit once no background shows the texture anymore, from any thread */
+	static void ReleaseMipLimit(const TWeakObjectPtr<UTexture2D>& Texture);
+
+	/** Hands a loaded texture over to Tick, which shows it once its wanted mips are resident */
+	static void SetPendingTexture(FPendingImage& InPendingImage, UTexture2D* Texture, EStretch::Type ImageStretch);
+
+	const FSlateBrush* GetImageBrush() const;
+
+	FSlateColor GetImageColor() const;
+
 	TSharedPtr<FDeferredCleanupSlateBrush> ImageBrush;
+
+	// Texture shown whose top mips are limited until the background is gone
+	TWeakObjectPtr<UTexture2D> MipLimitedTexture;
+
+	// Image being loaded or faded in, null once it's fully shown
+	TSharedPtr<FPendingImage, ESPMode::ThreadSafe> PendingImage;
+
+	// Time in second the image fades in over once loaded
+	float FadeInTime = 0.25f;
+
+	// Opacity of the image while it fades in
+	float FadeInAlpha = 1.0f;
 };
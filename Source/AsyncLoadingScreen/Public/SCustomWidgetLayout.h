@@ -0,0 +1,54 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "SLoadingScreenLayout.h"
+#include "Widgets/Layout/SScaleBox.h"
+
+struct FALoadingScreenSettings;
+class UUserWidget;
+
+/**
+ * Custom widget layout loading screen.
+ * Shows a built-in fallback layout while the custom widget class is loaded asynchronously, then swaps to the custom widget.
+ */
+class SCustomWidgetLayout : public SLoadingScreenLayout
+{
+public:
+	SLATE_BEGIN_ARGS(SCustomWidgetLayout) {}
+
+	SLATE_END_ARGS()
+
+	/**
+	 * Construct this widget
+	 */
+	void Construct(const FArguments& InArgs, const FALoadingScreenSettings& Settings);
+
+	// SWidget overrides
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
+	/** Starts loading a custom widget class ahead of its loading screen, it stays loaded until a layout uses it */
+	static void PreloadWidgetClass(const TSoftClassPtr<UUserWidget>& WidgetClass);
+
+	/** Releases the classes preloaded but never used, on module shutdown */
+	static void ReleasePreloadedWidgetClasses();
+
+private:
+	/** Hands the custom widget created on the game thread over to the thread painting the loading screen */
+	struct FPendingWidget
+	{
+		FCriticalSection CriticalSection;
+		TSharedPtr<SWidget> Widget;
+	};
+
+	/** Creates the custom widget and its root, on the game thread */
+	static TSharedRef<SWidget> MakeCustomWidget(UClass* WidgetClass, EStretch::Type ImageStretch);
+
+	TSharedPtr<FPendingWidget, ESPMode::ThreadSafe> PendingWidget;
+};
@@ -29,6 +29,9 @@ private:
 	// Active timer registered flag
 	bool bIsActiveTimerRegistered = false;
 
+	// Visibility the text was last reported with, showing it needs a repaint
+	mutable bool bWasVisible = false;
+
 public:
 	SLATE_BEGIN_ARGS(SLoadingCompleteText) {}
 
@@ -44,4 +47,7 @@ public:
 
 	/** Active timer event for animating the image sequence */
 	EActiveTimerReturnType AnimateText(double InCurrentTime, float InDeltaTime);
+
+	/** Next time the text has to be repainted at, see FLoadingScreenRedrawMetaData */
+	double GetNextPaintTime(double CurrentTime) const;
 };
@@ -0,0 +1,99 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "Widgets/SLeafWidget.h"
+
+class FDeferredCleanupSlateBrush;
+class FLoadingScreenImageStreamer;
+class UTexture2D;
+
+/**
+ * Plays an image sequence from a texture atlas, one brush drawn with a UV region per image, or streamed in image by image.
+ * The image is picked from the time elapsed since the frames were set, not from the number of paints.
+ */
+class ASYNCLOADINGSCREEN_API SLoadingFlipbook : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SLoadingFlipbook)
+		: _Interval(0.05f)
+		, _bPlayReverse(false)
+	{}
+
+		/** Time in second each image is shown, a zero value shows the next image every paint */
+		SLATE_ARGUMENT(float, Interval)
+		/** Play the images in reverse */
+		SLATE_ARGUMENT(bool, bPlayReverse)
+
+	SLATE_END_ARGS()
+
+	/** Constructs the widget */
+	void Construct(const FArguments& InArgs);
+
+	/**
+	 * Sets the images to play and restarts the animation.
+	 * With UV regions, the first brush is the atlas and each region is an image, otherwise each brush is a whole image.
+	 */
+	void SetFrames(const TArray<TSharedPtr<FDeferredCleanupSlateBrush>>& InBrushes, const TArray<FBox2D>& InUVRegions, const FVector2D& InFrameSize);
+
+	/** Plays the images streamed in by the streamer instead of a fixed set of frames */
+	void SetStreamer(const TSharedPtr<FLoadingScreenImageStreamer, ESPMode::ThreadSafe>& InStreamer);
+
+	/** Next time the flipbook has to be repainted at, see FLoadingScreenRedrawMetaData */
+	double GetNextPaintTime(double CurrentTime) const;
+
+	/**
+	 * Packs the images into a grid on a new render target and returns its brush, null if the atlas would exceed the maximum texture size.
+	 * Only the mips resident at the time are packed, streamed images may still be blurry right after loading.
+	 * Must be called on the game thread once the rendering thread is up.
+	 */
+	static TSharedPtr<FDeferredCleanupSlateBrush> PackAtlas(const TArray<UTexture2D*>& Images, TArray<FBox2D>& OutUVRegions);
+
+	/** Gets the UV regions of a pre-packed atlas made of GridSize cells, NumFrames of them being used */
+	static void GetGridUVRegions(const FIntPoint& GridSize, int32 NumFrames, TArray<FBox2D>& OutUVRegions);
+
+	// SWidget overrides
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float) const override;
+
+private:
+	/** Gets the number of images the flipbook plays */
+	int32 GetNumFrames() const;
+
+	/** Gets the image shown at CurrentTime */
+	int32 GetFrameIndex(double CurrentTime) const;
+
+	// Atlas brush or one brush per image
+	TArray<TSharedPtr<FDeferredCleanupSlateBrush>> Brushes;
+
+	// Streams the images in and out around the playhead, null when playing a fixed set of frames
+	TSharedPtr<FLoadingScreenImageStreamer, ESPMode::ThreadSafe> Streamer;
+
+	// Region of each image in the atlas, empty when every brush is an image
+	TArray<FBox2D> UVRegions;
+
+	// Copy of the atlas brush whose UV region is moved to the current image, keeps the resolved rendering resource
+	mutable FSlateBrush AtlasFrameBrush;
+
+	// Drawn size of an image
+	FVector2D FrameSize = FVector2D::ZeroVector;
+
+	// Time the animation started at
+	double StartTime = 0.0;
+
+	// Number of paints since the animation started, drives the animation when Interval is zero
+	mutable int32 NumPaints = 0;
+
+	// The frames were changed and haven't been painted yet
+	mutable bool bFramesChanged = false;
+
+	float Interval = 0.05f;
+
+	bool bPlayReverse = false;
+};
@@ -19,4 +19,10 @@ public:
 	static float PointSizeToSlateUnits(float PointSize);
 protected:
 	float GetDPIScale() const;	
+
+	/**
+	 * Wraps the layout in an invalidation panel unless disabled in the performance settings,
+	 * so only its volatile (animated) widgets are repainted every frame and the static layers are reused.
+	 */
+	static TSharedRef<SWidget> MakeCachedLayout(const TSharedRef<SWidget>& Layout);
 };
@@ -11,8 +11,10 @@
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/Images/SThrobber.h"
 #include "LoadingScreenSettings.h"
+#include "UObject/StrongObjectPtr.h"
 
 class FDeferredCleanupSlateBrush;
+class SLoadingFlipbook;
 struct FLoadingWidgetSettings;
 
 /**
@@ -23,6 +25,7 @@ class SLoadingWidget : public SCompoundWidget
 public:
 
 	// SWidgetOverrides
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
 	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 
 	/** Gets the combined value of the animation properties as a single SThrobber::EAnimation value. */
@@ -31,20 +34,72 @@ public:
 	/** Construct loading icon*/
 	void ConstructLoadingIcon(const FLoadingWidgetSettings& Settings);
 
+	/** Next time the loading icon has to be repainted at, see FLoadingScreenRedrawMetaData */
+	double GetNextPaintTime(double CurrentTime) const;
+
 protected:
+	/** Brushes of the image sequence, either one per image or a single atlas brush with one UV region per image */
+	struct FImageSequence
+	{
+		TArray<TSharedPtr<FDeferredCleanupSlateBrush>> Brushes;
+		TArray<FBox2D> UVRegions;
+		FVector2D FrameSize = FVector2D::ZeroVector;
+	};
+
+	/** Hands the asynchronously loaded image sequence over from the game thread to the thread painting the loading screen */
+	struct FPendingImages
+	{
+		FCriticalSection CriticalSection;
+		FImageSequence ImageSequence;
+		int32 NumPendingPackages = 0;
+		bool bArrived = false;
+
+		// Images of the packages loaded so far, kept from garbage collection until the last package of the batch is in. Game thread only
+		TArray<TStrongObjectPtr<UTexture2D>> LoadedImages;
+	};
+
+	/** Gets the textures the image sequence is drawn from, the pre-packed atlas or the images */
+	static void GetImageSequenceAssets(const FImageSequenceSettings& ImageSequenceSettings, TArray<TSoftObjectPtr<UTexture2D>>& OutAssets);
+
+	/**
+	 * Creates the brushes of the image sequence on the game thread, skipping the images that aren't loaded.
+	 * The textures drawn are kept with the loading screen CachedScreenName in the loading screen asset cache.
+	 */
+	static FImageSequence CreateImageSequence(const FImageSequenceSettings& ImageSequenceSettings, const FName& CachedScreenName);
+
+	/** Shows the image sequence in the loading icon */
+	void SetImageSequence(FImageSequence&& ImageSequence);
+
+	/** Batch loads the packages of the image sequence at high priority, the brushes are picked up in Tick once they are all loaded */
+	void RequestImageSequenceAsync(const FImageSequenceSettings& ImageSequenceSettings);
+
+	TSharedPtr<FPendingImages, ESPMode::ThreadSafe> PendingImages;
+
 	// Placeholder widgets
 	TSharedRef<SWidget> LoadingIcon = SNullWidget::NullWidget;
 	// Image slate brush list
 	TArray<TSharedPtr<FDeferredCleanupSlateBrush>> CleanupBrushList;	
 
+	// Loading icon playing the image sequence from an atlas, null unless bUseAtlas is set
+	TSharedPtr<SLoadingFlipbook> LoadingFlipbook;
+
 	// Play image sequence in reverse
 	bool bPlayReverse = false;
 
 	// Current image sequence index
 	mutable int32 ImageIndex = 0;
 
-	// Current total delta time
-	mutable float TotalDeltaTime = 0.0f;
+	// Time the image sequence started playing, the image index follows from it
+	double StartTime = 0.0;
+
+	// Number of paints since the image sequence started, drives the image index when Interval is zero
+	mutable int64 NumPaints = 0;
+
+	// Visibility the loading icon was last reported with, hiding or showing it needs a repaint
+	mutable bool bWasVisible = true;
+
+	// Is the loading icon an image sequence rather than a throbber
+	bool bIsImageSequence = false;
 
 	//Time in second to update the images, the smaller value the faster of the animation. A zero value will update the images every frame.
 	float Interval = 0.05f;	